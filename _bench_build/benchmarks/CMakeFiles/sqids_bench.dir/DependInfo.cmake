@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmarks/cacheBenchmarks.cpp" "benchmarks/CMakeFiles/sqids_bench.dir/cacheBenchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/sqids_bench.dir/cacheBenchmarks.cpp.o.d"
+  "/root/repo/benchmarks/constructionBenchmarks.cpp" "benchmarks/CMakeFiles/sqids_bench.dir/constructionBenchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/sqids_bench.dir/constructionBenchmarks.cpp.o.d"
+  "/root/repo/benchmarks/decodingBenchmarks.cpp" "benchmarks/CMakeFiles/sqids_bench.dir/decodingBenchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/sqids_bench.dir/decodingBenchmarks.cpp.o.d"
+  "/root/repo/benchmarks/encodingBenchmarks.cpp" "benchmarks/CMakeFiles/sqids_bench.dir/encodingBenchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/sqids_bench.dir/encodingBenchmarks.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
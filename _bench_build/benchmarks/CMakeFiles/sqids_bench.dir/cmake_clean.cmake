@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids_bench.dir/cacheBenchmarks.cpp.o"
+  "CMakeFiles/sqids_bench.dir/cacheBenchmarks.cpp.o.d"
+  "CMakeFiles/sqids_bench.dir/constructionBenchmarks.cpp.o"
+  "CMakeFiles/sqids_bench.dir/constructionBenchmarks.cpp.o.d"
+  "CMakeFiles/sqids_bench.dir/decodingBenchmarks.cpp.o"
+  "CMakeFiles/sqids_bench.dir/decodingBenchmarks.cpp.o.d"
+  "CMakeFiles/sqids_bench.dir/encodingBenchmarks.cpp.o"
+  "CMakeFiles/sqids_bench.dir/encodingBenchmarks.cpp.o.d"
+  "sqids_bench"
+  "sqids_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
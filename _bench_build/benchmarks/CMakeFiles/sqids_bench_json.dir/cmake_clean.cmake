@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids_bench_json"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/sqids_bench_json.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids_cxx20_tests.dir/allocatorTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/allocatorTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/alphabetTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/alphabetTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/batchTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/batchTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/blocklistTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/blocklistTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/cacheTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/cacheTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/canonicalTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/canonicalTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/encodingTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/encodingTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/errorTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/errorTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/fixedTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/fixedTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/integerTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/integerTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/minLengthTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/minLengthTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/parallelTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/parallelTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/registryTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/registryTests.cpp.o.d"
+  "CMakeFiles/sqids_cxx20_tests.dir/streamTests.cpp.o"
+  "CMakeFiles/sqids_cxx20_tests.dir/streamTests.cpp.o.d"
+  "sqids_cxx20_tests"
+  "sqids_cxx20_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids_cxx20_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
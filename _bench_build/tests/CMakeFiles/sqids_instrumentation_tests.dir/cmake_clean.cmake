@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids_instrumentation_tests.dir/instrumentationTests.cpp.o"
+  "CMakeFiles/sqids_instrumentation_tests.dir/instrumentationTests.cpp.o.d"
+  "sqids_instrumentation_tests"
+  "sqids_instrumentation_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids_instrumentation_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids_no_exceptions_tests.dir/errorTests.cpp.o"
+  "CMakeFiles/sqids_no_exceptions_tests.dir/errorTests.cpp.o.d"
+  "sqids_no_exceptions_tests"
+  "sqids_no_exceptions_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids_no_exceptions_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/allocatorTests.cpp" "tests/CMakeFiles/sqids_tests.dir/allocatorTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/allocatorTests.cpp.o.d"
+  "/root/repo/tests/alphabetTests.cpp" "tests/CMakeFiles/sqids_tests.dir/alphabetTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/alphabetTests.cpp.o.d"
+  "/root/repo/tests/batchTests.cpp" "tests/CMakeFiles/sqids_tests.dir/batchTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/batchTests.cpp.o.d"
+  "/root/repo/tests/blocklistTests.cpp" "tests/CMakeFiles/sqids_tests.dir/blocklistTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/blocklistTests.cpp.o.d"
+  "/root/repo/tests/cacheTests.cpp" "tests/CMakeFiles/sqids_tests.dir/cacheTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/cacheTests.cpp.o.d"
+  "/root/repo/tests/canonicalTests.cpp" "tests/CMakeFiles/sqids_tests.dir/canonicalTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/canonicalTests.cpp.o.d"
+  "/root/repo/tests/encodingTests.cpp" "tests/CMakeFiles/sqids_tests.dir/encodingTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/encodingTests.cpp.o.d"
+  "/root/repo/tests/errorTests.cpp" "tests/CMakeFiles/sqids_tests.dir/errorTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/errorTests.cpp.o.d"
+  "/root/repo/tests/fixedTests.cpp" "tests/CMakeFiles/sqids_tests.dir/fixedTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/fixedTests.cpp.o.d"
+  "/root/repo/tests/integerTests.cpp" "tests/CMakeFiles/sqids_tests.dir/integerTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/integerTests.cpp.o.d"
+  "/root/repo/tests/minLengthTests.cpp" "tests/CMakeFiles/sqids_tests.dir/minLengthTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/minLengthTests.cpp.o.d"
+  "/root/repo/tests/parallelTests.cpp" "tests/CMakeFiles/sqids_tests.dir/parallelTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/parallelTests.cpp.o.d"
+  "/root/repo/tests/registryTests.cpp" "tests/CMakeFiles/sqids_tests.dir/registryTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/registryTests.cpp.o.d"
+  "/root/repo/tests/streamTests.cpp" "tests/CMakeFiles/sqids_tests.dir/streamTests.cpp.o" "gcc" "tests/CMakeFiles/sqids_tests.dir/streamTests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids-blocklist.dir/blocklist.cpp.o"
+  "CMakeFiles/sqids-blocklist.dir/blocklist.cpp.o.d"
+  "sqids-blocklist"
+  "sqids-blocklist.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids-blocklist.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
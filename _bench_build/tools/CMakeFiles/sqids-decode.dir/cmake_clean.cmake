@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sqids-decode.dir/decode.cpp.o"
+  "CMakeFiles/sqids-decode.dir/decode.cpp.o.d"
+  "sqids-decode"
+  "sqids-decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sqids-decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
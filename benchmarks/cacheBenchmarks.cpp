@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <sqids/cache.hpp>
+
+// Skewed traffic: 9 in 10 lookups go to 1000 hot numbers, the rest are
+// spread over a million
+static std::vector<uint64_t> skewedNumbers(size_t count) {
+    std::vector<uint64_t> numbers;
+    uint64_t state = 42;
+    for (size_t i = 0; i < count; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const uint64_t random = state >> 11;
+        numbers.push_back(random % 10 == 0 ? 1000 + random % 1000000 : random % 1000);
+    }
+    return numbers;
+}
+
+// The instances shared by the threads of a benchmark. They are created by
+// the first thread before the others start, and destroyed once all of them
+// are done, so that nothing outlives the benchmark.
+struct CacheFixture
+{
+    sqidscxx::Sqids<> sqids;
+    sqidscxx::CachedSqids<> uncached { sqids, 0 };
+    sqidscxx::CachedSqids<> cached { sqids, 4096 };
+    std::vector<uint64_t> numbers = skewedNumbers(4096);
+    std::vector<std::string> ids;
+};
+
+static std::unique_ptr<CacheFixture> fixture;
+
+// Encode (shard, row) pairs of skewed traffic, without a cache if
+// `range(0)` is 0, and with a cache of 4096 IDs in each direction otherwise
+static void EncodeCached(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        fixture = std::make_unique<CacheFixture>();
+    }
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        auto& sqids = state.range(0) == 0 ? fixture->uncached : fixture->cached;
+        benchmark::DoNotOptimize(sqids.encode({ 7, fixture->numbers[i++ % fixture->numbers.size()] }));
+    }
+
+    if (state.thread_index() == 0) {
+        fixture.reset();
+    }
+}
+BENCHMARK(EncodeCached)->Arg(0)->Arg(4096)->Threads(1)->Threads(4);
+
+// The same, decoding the IDs
+static void DecodeCached(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        fixture = std::make_unique<CacheFixture>();
+        for (const auto number : fixture->numbers) {
+            fixture->ids.push_back(fixture->sqids.encode({ 7, number }));
+        }
+    }
+
+    size_t i = state.thread_index();
+    for (auto _ : state) {
+        auto& sqids = state.range(0) == 0 ? fixture->uncached : fixture->cached;
+        benchmark::DoNotOptimize(sqids.decode(fixture->ids[i++ % fixture->ids.size()]));
+    }
+
+    if (state.thread_index() == 0) {
+        fixture.reset();
+    }
+}
+BENCHMARK(DecodeCached)->Arg(0)->Arg(4096)->Threads(1)->Threads(4);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <sqids/fixed.hpp>
+
+// What the first instance using the default blocklist pays, once for each
+// set of alphabet characters: compiling the default words into a matcher
+static void CompileDefaultBlocklist(benchmark::State& state) {
+    const std::string alphabet = sqidscxx::SqidsOptions().alphabet;
+
+    for (auto _ : state) {
+        sqidscxx::BlocklistMatcher matcher(sqidscxx::DEFAULT_BLOCKLIST_WORDS, alphabet);
+        benchmark::DoNotOptimize(matcher);
+    }
+}
+BENCHMARK(CompileDefaultBlocklist);
+
+// What every other instance pays. The default matcher is compiled before
+// timing, so that the result doesn't depend on which benchmarks ran earlier.
+static void ConstructWithDefaultBlocklist(benchmark::State& state) {
+    sqidscxx::Blocklist::defaults().compile(sqidscxx::SqidsOptions().alphabet);
+
+    for (auto _ : state) {
+        sqidscxx::Sqids<> sqids;
+        benchmark::DoNotOptimize(sqids);
+    }
+}
+BENCHMARK(ConstructWithDefaultBlocklist);
+
+static void ConstructWithoutBlocklist(benchmark::State& state) {
+    sqidscxx::SqidsOptions options;
+    options.blocklist.clear();
+
+    for (auto _ : state) {
+        sqidscxx::Sqids<> sqids(options);
+        benchmark::DoNotOptimize(sqids);
+    }
+}
+BENCHMARK(ConstructWithoutBlocklist);
+
+static void ConstructWithAlphabetCache(benchmark::State& state) {
+    sqidscxx::SqidsOptions options;
+    options.alphabetCacheDepth = static_cast<uint8_t>(state.range(0));
+    sqidscxx::Blocklist::defaults().compile(options.alphabet);
+
+    for (auto _ : state) {
+        sqidscxx::Sqids<> sqids(options);
+        benchmark::DoNotOptimize(sqids);
+    }
+}
+BENCHMARK(ConstructWithAlphabetCache)->Arg(1)->Arg(4);
+
+// Everything but the blocklist lookup is computed at compile time
+static void ConstructFixed(benchmark::State& state) {
+    for (auto _ : state) {
+        sqidscxx::FixedSqids<> sqids;
+        benchmark::DoNotOptimize(sqids);
+    }
+}
+BENCHMARK(ConstructFixed);
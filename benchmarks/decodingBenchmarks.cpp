@@ -0,0 +1,222 @@
+#include <benchmark/benchmark.h>
+#include <sqids/sqids.hpp>
+
+// Decode IDs holding a single number
+template<typename T>
+static void DecodeSingle(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+
+    std::vector<std::string> ids;
+    for (T i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ static_cast<T>(i * 2654435761u) }));
+    }
+
+    T number;
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decodeInto(ids[i++ % ids.size()], &number, 1));
+    }
+}
+BENCHMARK_TEMPLATE(DecodeSingle, uint32_t);
+BENCHMARK_TEMPLATE(DecodeSingle, uint64_t);
+
+#if defined(__SIZEOF_INT128__)
+// Decode IDs holding a single number that uses all 128 bits
+template<typename T>
+static void DecodeWide(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        const uint64_t low = i * 0x9E3779B97F4A7C15u;
+        const uint64_t high = ~low >> (i % 8);
+        if constexpr (std::is_same_v<T, sqidscxx::BigUint<128>>) {
+            ids.push_back(sqids.encode({ T({ low, high }) }));
+        } else {
+            ids.push_back(sqids.encode({ (static_cast<T>(high) << 64) | low }));
+        }
+    }
+
+    T number;
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decodeInto(ids[i++ % ids.size()], &number, 1));
+    }
+}
+BENCHMARK_TEMPLATE(DecodeWide, unsigned __int128);
+BENCHMARK_TEMPLATE(DecodeWide, sqidscxx::BigUint<128>);
+#endif
+
+// Decode an ID holding `range(0)` numbers
+template<typename T>
+static void DecodeMultiple(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+
+    std::vector<T> numbers;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        numbers.push_back(static_cast<T>(i * 2654435761u));
+    }
+    const auto id = sqids.encode(numbers);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode(id));
+    }
+}
+BENCHMARK_TEMPLATE(DecodeMultiple, uint32_t)->Arg(2)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(DecodeMultiple, uint64_t)->Arg(2)->Arg(4)->Arg(16);
+
+// Decode (shard, row) pairs into a vector
+static void DecodePairVector(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ 7, i * 2654435761u }));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode(ids[i++ % ids.size()]));
+    }
+}
+BENCHMARK(DecodePairVector);
+
+// The same, into a fixed-size array
+static void DecodePairArray(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ 7, i * 2654435761u }));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode<2>(ids[i++ % ids.size()]));
+    }
+}
+BENCHMARK(DecodePairArray);
+
+#if SQIDS_PMR
+// The same, into a vector allocated from a per-request arena
+static void DecodePairArena(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ 7, i * 2654435761u }));
+    }
+
+    char storage[1024];
+    size_t i = 0;
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage));
+        benchmark::DoNotOptimize(sqids.decode(ids[i++ % ids.size()], &arena));
+    }
+}
+BENCHMARK(DecodePairArena);
+#endif
+
+// Decode IDs padded to a minimum length of `range(0)`
+static void DecodeMinLength(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids({ minLength: static_cast<uint8_t>(state.range(0)) });
+    const auto id = sqids.encode({ 1, 2, 3 });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode(id));
+    }
+}
+BENCHMARK(DecodeMinLength)->Arg(0)->Arg(10)->Arg(40)->Arg(255);
+
+// Decode pairs with canonical decoding off or on (`range(0)`), from IDs
+// padded to a minimum length of `range(1)`
+static void DecodeCanonical(benchmark::State& state) {
+    sqidscxx::SqidsOptions options;
+    options.minLength = static_cast<uint8_t>(state.range(1));
+    options.canonicalDecoding = state.range(0) != 0;
+
+    sqidscxx::Sqids<> sqids(options);
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ i % 16, i * 2654435761u }));
+    }
+
+    uint64_t numbers[2];
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decodeInto(ids[i++ % ids.size()], numbers, 2));
+    }
+}
+BENCHMARK(DecodeCanonical)->ArgsProduct({ { 0, 1 }, { 0, 32 } });
+
+// Reject IDs containing a character that isn't in the alphabet
+static void DecodeInvalid(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+
+    std::string id(state.range(0), 'a');
+    id.back() = '*';
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode(id));
+    }
+}
+BENCHMARK(DecodeInvalid)->Arg(8)->Arg(40)->Arg(255);
+
+// Decode with custom alphabets of `range(0)` characters
+static void DecodeAlphabetSize(benchmark::State& state) {
+    const std::string characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()-_+|{}[];:'\"/?.>,<`~";
+
+    sqidscxx::Sqids<> sqids({ alphabet: characters.substr(0, state.range(0)) });
+    const auto id = sqids.encode({ 1'000'000, 2'000'000 });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.decode(id));
+    }
+}
+BENCHMARK(DecodeAlphabetSize)->Arg(3)->Arg(16)->Arg(62)->Arg(90);
+
+// Decode a page of 1024 IDs at once
+static void DecodeBatch(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 1024; i++) {
+        numbers.push_back(i * 2654435761u);
+    }
+
+    sqidscxx::EncodedBatch ids;
+    sqids.encodeBatch(numbers.data(), numbers.size(), 1, ids);
+
+    sqidscxx::DecodedBatch<uint64_t> decoded;
+    for (auto _ : state) {
+        sqids.decodeBatch(ids, decoded);
+        benchmark::DoNotOptimize(decoded.numbers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(DecodeBatch);
+
+// Route (shard, table, row) IDs padded to `range(0)` characters by their
+// first number, decoding all of the ID (`range(1)` is 0) or only the first
+// number
+static void DecodeFirst(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids({ minLength: static_cast<uint8_t>(state.range(0)) });
+
+    std::vector<std::string> ids;
+    for (uint64_t i = 0; i < 1024; i++) {
+        ids.push_back(sqids.encode({ i % 16, 3, i * 2654435761u }));
+    }
+
+    uint64_t numbers[3];
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& id = ids[i++ % ids.size()];
+        if (state.range(1) == 0) {
+            benchmark::DoNotOptimize(sqids.decodeInto(id, numbers, 3));
+        } else {
+            benchmark::DoNotOptimize(sqids.decodeFirst(id));
+        }
+    }
+}
+BENCHMARK(DecodeFirst)->ArgsProduct({ { 0, 32, 255 }, { 0, 1 } });
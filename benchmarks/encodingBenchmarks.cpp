@@ -0,0 +1,248 @@
+#include <benchmark/benchmark.h>
+#include <sqids/sqids.hpp>
+
+template<typename T>
+static std::vector<T> randomNumbers(size_t count) {
+    std::vector<T> numbers;
+    uint64_t state = 42;
+    for (size_t i = 0; i < count; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        numbers.push_back(static_cast<T>(state >> 11));
+    }
+    return numbers;
+}
+
+// Encode a different single number on every iteration
+template<typename T>
+static void EncodeSingle(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+    const auto numbers = randomNumbers<T>(1024);
+
+    std::string id;
+    size_t i = 0;
+    for (auto _ : state) {
+        sqids.encodeInto(&numbers[i++ % numbers.size()], 1, id);
+        benchmark::DoNotOptimize(id.data());
+    }
+}
+BENCHMARK_TEMPLATE(EncodeSingle, uint32_t);
+BENCHMARK_TEMPLATE(EncodeSingle, uint64_t);
+
+#if defined(__SIZEOF_INT128__)
+// A 128-bit integer divided with the native division operator, to compare
+// with the limb-wise division
+struct NativeUint128
+{
+    constexpr NativeUint128(unsigned __int128 _value = 0) : value(_value) {}
+
+    unsigned __int128 value;
+};
+
+static bool operator>(const NativeUint128& a, const NativeUint128& b) { return a.value > b.value; }
+
+template<>
+struct sqidscxx::IntegerTraits<NativeUint128>
+{
+    static constexpr NativeUint128 max() { return ~static_cast<unsigned __int128>(0); }
+    static bool isNegative(const NativeUint128&) { return false; }
+    static bool isZero(const NativeUint128& n) { return n.value == 0; }
+
+    static bool toUint64(const NativeUint128& n, uint64_t& value)
+    {
+        value = static_cast<uint64_t>(n.value);
+        return (n.value >> 64) == 0;
+    }
+    static uint64_t remainder(const NativeUint128& n, const Divider& divider) { return n.value % divider.divisor(); }
+
+    static uint64_t divide(NativeUint128& n, const Divider& divider)
+    {
+        const uint64_t remainder = n.value % divider.divisor();
+        n.value /= divider.divisor();
+        return remainder;
+    }
+
+    static void multiplyAdd(NativeUint128& n, uint64_t factor, uint64_t addend) { n.value = n.value * factor + addend; }
+    static std::string toString(const NativeUint128&) { return "2^128 - 1"; }
+};
+
+// Numbers using all 128 bits
+template<typename T>
+static std::vector<T> wideNumbers(size_t count) {
+    const auto halves = randomNumbers<uint64_t>(2 * count);
+
+    std::vector<T> numbers;
+    for (size_t i = 0; i < count; i++) {
+        const unsigned __int128 value = (static_cast<unsigned __int128>(halves[2 * i + 1]) << 75) | halves[2 * i];
+        if constexpr (std::is_same_v<T, sqidscxx::BigUint<128>>) {
+            numbers.push_back(T({ static_cast<uint64_t>(value), static_cast<uint64_t>(value >> 64) }));
+        } else {
+            numbers.push_back(T(value));
+        }
+    }
+    return numbers;
+}
+
+// Encode a different 128-bit number on every iteration
+template<typename T>
+static void EncodeWide(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+    const auto numbers = wideNumbers<T>(1024);
+
+    std::string id;
+    size_t i = 0;
+    for (auto _ : state) {
+        sqids.encodeInto(&numbers[i++ % numbers.size()], 1, id);
+        benchmark::DoNotOptimize(id.data());
+    }
+}
+BENCHMARK_TEMPLATE(EncodeWide, unsigned __int128);
+BENCHMARK_TEMPLATE(EncodeWide, sqidscxx::BigUint<128>);
+BENCHMARK_TEMPLATE(EncodeWide, NativeUint128);
+#endif
+
+// Encode `range(0)` numbers into one ID
+template<typename T>
+static void EncodeMultiple(benchmark::State& state) {
+    sqidscxx::Sqids<T> sqids;
+    const auto numbers = randomNumbers<T>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK_TEMPLATE(EncodeMultiple, uint32_t)->Arg(2)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(EncodeMultiple, uint64_t)->Arg(2)->Arg(4)->Arg(16);
+
+// Encode (shard, row) pairs from a vector, as most callers do
+static void EncodePairVector(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+    const auto numbers = randomNumbers<uint64_t>(1024);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const uint64_t row = numbers[i++ % numbers.size()] >> 24;
+        benchmark::DoNotOptimize(sqids.encode(std::vector<uint64_t> { 7, row }));
+    }
+}
+BENCHMARK(EncodePairVector);
+
+// The same, from a fixed-size array
+static void EncodePairArray(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+    const auto numbers = randomNumbers<uint64_t>(1024);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const uint64_t row = numbers[i++ % numbers.size()] >> 24;
+        benchmark::DoNotOptimize(sqids.encode(std::array<uint64_t, 2> { 7, row }));
+    }
+}
+BENCHMARK(EncodePairArray);
+
+#if SQIDS_PMR
+// The same, allocating the ID from a per-request arena
+static void EncodePairArena(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+    const auto numbers = randomNumbers<uint64_t>(1024);
+
+    char storage[1024];
+    size_t i = 0;
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage));
+
+        const uint64_t pair[] = { 7, numbers[i++ % numbers.size()] >> 24 };
+        benchmark::DoNotOptimize(sqids.encode(pair, 2, &arena));
+    }
+}
+BENCHMARK(EncodePairArena);
+#endif
+
+// Pad IDs to a minimum length of `range(0)`
+static void EncodeMinLength(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids({ minLength: static_cast<uint8_t>(state.range(0)) });
+    const auto numbers = sqids.numbers({ 1, 2, 3 });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK(EncodeMinLength)->Arg(0)->Arg(10)->Arg(40)->Arg(255);
+
+// Block the first `range(0)` IDs generated for the same input, so that
+// encoding has to re-generate the ID that many times
+static void EncodeBlocked(benchmark::State& state) {
+    const auto numbers = randomNumbers<uint64_t>(2);
+
+    sqidscxx::SqidsOptions options;
+    options.blocklist.clear();
+    for (int64_t i = 0; i < state.range(0); i++) {
+        options.blocklist.insert(sqidscxx::Sqids<>(options).encode(numbers));
+    }
+
+    sqidscxx::Sqids<> sqids(options);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK(EncodeBlocked)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->Arg(61);
+
+// The same, for IDs padded to a minimum length
+static void EncodeBlockedMinLength(benchmark::State& state) {
+    const auto numbers = randomNumbers<uint64_t>(2);
+
+    sqidscxx::SqidsOptions options;
+    options.minLength = 32;
+    options.blocklist.clear();
+    for (int64_t i = 0; i < state.range(0); i++) {
+        options.blocklist.insert(sqidscxx::Sqids<>(options).encode(numbers));
+    }
+
+    sqidscxx::Sqids<> sqids(options);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK(EncodeBlockedMinLength)->Arg(0)->Arg(16)->Arg(61);
+
+// Encode with custom alphabets of `range(0)` characters
+static void EncodeAlphabetSize(benchmark::State& state) {
+    const std::string characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()-_+|{}[];:'\"/?.>,<`~";
+
+    sqidscxx::Sqids<> sqids({ alphabet: characters.substr(0, state.range(0)) });
+    const auto numbers = randomNumbers<uint64_t>(2);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK(EncodeAlphabetSize)->Arg(3)->Arg(16)->Arg(62)->Arg(90);
+
+// Encode with `range(0)` precomputed alphabet generations
+static void EncodeAlphabetCache(benchmark::State& state) {
+    sqidscxx::SqidsOptions options;
+    options.alphabetCacheDepth = static_cast<uint8_t>(state.range(0));
+
+    sqidscxx::Sqids<> sqids(options);
+    const auto numbers = randomNumbers<uint64_t>(4);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqids.encode(numbers));
+    }
+}
+BENCHMARK(EncodeAlphabetCache)->Arg(0)->Arg(1)->Arg(4);
+
+// Encode a page of 1024 single numbers at once
+static void EncodeBatch(benchmark::State& state) {
+    sqidscxx::Sqids<> sqids;
+    const auto numbers = randomNumbers<uint64_t>(1024);
+
+    sqidscxx::EncodedBatch ids;
+    for (auto _ : state) {
+        sqids.encodeBatch(numbers.data(), numbers.size(), 1, ids);
+        benchmark::DoNotOptimize(ids.buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(EncodeBatch);
@@ -3,10 +3,453 @@
 ///
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include "error.hpp"
+#include "matcher.hpp"
 
 namespace sqidscxx
 {
-const std::set<std::string> DEFAULT_BLOCKLIST = { "0rgasm", "1d10t", "1d1ot", "1di0t", "1diot", "1eccacu10", "1eccacu1o", "1eccacul0", "1eccaculo", "1mbec11e", "1mbec1le", "1mbeci1e", "1mbecile", "a11upat0", "a11upato", "a1lupat0", "a1lupato", "aand", "ah01e", "ah0le", "aho1e", "ahole", "al1upat0", "al1upato", "allupat0", "allupato", "ana1", "ana1e", "anal", "anale", "anus", "arrapat0", "arrapato", "arsch", "arse", "ass", "b00b", "b00be", "b01ata", "b0ceta", "b0iata", "b0ob", "b0obe", "b0sta", "b1tch", "b1te", "b1tte", "ba1atkar", "balatkar", "bastard0", "bastardo", "batt0na", "battona", "bitch", "bite", "bitte", "bo0b", "bo0be", "bo1ata", "boceta", "boiata", "boob", "boobe", "bosta", "bran1age", "bran1er", "bran1ette", "bran1eur", "bran1euse", "branlage", "branler", "branlette", "branleur", "branleuse", "c0ck", "c0g110ne", "c0g11one", "c0g1i0ne", "c0g1ione", "c0gl10ne", "c0gl1one", "c0gli0ne", "c0glione", "c0na", "c0nnard", "c0nnasse", "c0nne", "c0u111es", "c0u11les", "c0u1l1es", "c0u1lles", "c0ui11es", "c0ui1les", "c0uil1es", "c0uilles", "c11t", "c11t0", "c11to", "c1it", "c1it0", "c1ito", "cabr0n", "cabra0", "cabrao", "cabron", "caca", "cacca", "cacete", "cagante", "cagar", "cagare", "cagna", "cara1h0", "cara1ho", "caracu10", "caracu1o", "caracul0", "caraculo", "caralh0", "caralho", "cazz0", "cazz1mma", "cazzata", "cazzimma", "cazzo", "ch00t1a", "ch00t1ya", "ch00tia", "ch00tiya", "ch0d", "ch0ot1a", "ch0ot1ya", "ch0otia", "ch0otiya", "ch1asse", "ch1avata", "ch1er", "ch1ng0", "ch1ngadaz0s", "ch1ngadazos", "ch1ngader1ta", "ch1ngaderita", "ch1ngar", "ch1ngo", "ch1ngues", "ch1nk", "chatte", "chiasse", "chiavata", "chier", "ching0", "chingadaz0s", "chingadazos", "chingader1ta", "chingaderita", "chingar", "chingo", "chingues", "chink", "cho0t1a", "cho0t1ya", "cho0tia", "cho0tiya", "chod", "choot1a", "choot1ya", "chootia", "chootiya", "cl1t", "cl1t0", "cl1to", "clit", "clit0", "clito", "cock", "cog110ne", "cog11one", "cog1i0ne", "cog1ione", "cogl10ne", "cogl1one", "cogli0ne", "coglione", "cona", "connard", "connasse", "conne", "cou111es", "cou11les", "cou1l1es", "cou1lles", "coui11es", "coui1les", "couil1es", "couilles", "cracker", "crap", "cu10", "cu1att0ne", "cu1attone", "cu1er0", "cu1ero", "cu1o", "cul0", "culatt0ne", "culattone", "culer0", "culero", "culo", "cum", "cunt", "d11d0", "d11do", "d1ck", "d1ld0", "d1ldo", "damn", "de1ch", "deich", "depp", "di1d0", "di1do", "dick", "dild0", "dildo", "dyke", "encu1e", "encule", "enema", "enf01re", "enf0ire", "enfo1re", "enfoire", "estup1d0", "estup1do", "estupid0", "estupido", "etr0n", "etron", "f0da", "f0der", "f0ttere", "f0tters1", "f0ttersi", "f0tze", "f0utre", "f1ca", "f1cker", "f1ga", "fag", "fica", "ficker", "figa", "foda", "foder", "fottere", "fotters1", "fottersi", "fotze", "foutre", "fr0c10", "fr0c1o", "fr0ci0", "fr0cio", "fr0sc10", "fr0sc1o", "fr0sci0", "fr0scio", "froc10", "froc1o", "froci0", "frocio", "frosc10", "frosc1o", "frosci0", "froscio", "fuck", "g00", "g0o", "g0u1ne", "g0uine", "gandu", "go0", "goo", "gou1ne", "gouine", "gr0gnasse", "grognasse", "haram1", "harami", "haramzade", "hund1n", "hundin", "id10t", "id1ot", "idi0t", "idiot", "imbec11e", "imbec1le", "imbeci1e", "imbecile", "j1zz", "jerk", "jizz", "k1ke", "kam1ne", "kamine", "kike", "leccacu10", "leccacu1o", "leccacul0", "leccaculo", "m1erda", "m1gn0tta", "m1gnotta", "m1nch1a", "m1nchia", "m1st", "mam0n", "mamahuev0", "mamahuevo", "mamon", "masturbat10n", "masturbat1on", "masturbate", "masturbati0n", "masturbation", "merd0s0", "merd0so", "merda", "merde", "merdos0", "merdoso", "mierda", "mign0tta", "mignotta", "minch1a", "minchia", "mist", "musch1", "muschi", "n1gger", "neger", "negr0", "negre", "negro", "nerch1a", "nerchia", "nigger", "orgasm", "p00p", "p011a", "p01la", "p0l1a", "p0lla", "p0mp1n0", "p0mp1no", "p0mpin0", "p0mpino", "p0op", "p0rca", "p0rn", "p0rra", "p0uff1asse", "p0uffiasse", "p1p1", "p1pi", "p1r1a", "p1rla", "p1sc10", "p1sc1o", "p1sci0", "p1scio", "p1sser", "pa11e", "pa1le", "pal1e", "palle", "pane1e1r0", "pane1e1ro", "pane1eir0", "pane1eiro", "panele1r0", "panele1ro", "paneleir0", "paneleiro", "patakha", "pec0r1na", "pec0rina", "pecor1na", "pecorina", "pen1s", "pendej0", "pendejo", "penis", "pip1", "pipi", "pir1a", "pirla", "pisc10", "pisc1o", "pisci0", "piscio", "pisser", "po0p", "po11a", "po1la", "pol1a", "polla", "pomp1n0", "pomp1no", "pompin0", "pompino", "poop", "porca", "porn", "porra", "pouff1asse", "pouffiasse", "pr1ck", "prick", "pussy", "put1za", "puta", "puta1n", "putain", "pute", "putiza", "puttana", "queca", "r0mp1ba11e", "r0mp1ba1le", "r0mp1bal1e", "r0mp1balle", "r0mpiba11e", "r0mpiba1le", "r0mpibal1e", "r0mpiballe", "rand1", "randi", "rape", "recch10ne", "recch1one", "recchi0ne", "recchione", "retard", "romp1ba11e", "romp1ba1le", "romp1bal1e", "romp1balle", "rompiba11e", "rompiba1le", "rompibal1e", "rompiballe", "ruff1an0", "ruff1ano", "ruffian0", "ruffiano", "s1ut", "sa10pe", "sa1aud", "sa1ope", "sacanagem", "sal0pe", "salaud", "salope", "saugnapf", "sb0rr0ne", "sb0rra", "sb0rrone", "sbattere", "sbatters1", "sbattersi", "sborr0ne", "sborra", "sborrone", "sc0pare", "sc0pata", "sch1ampe", "sche1se", "sche1sse", "scheise", "scheisse", "schlampe", "schwachs1nn1g", "schwachs1nnig", "schwachsinn1g", "schwachsinnig", "schwanz", "scopare", "scopata", "sexy", "sh1t", "shit", "slut", "sp0mp1nare", "sp0mpinare", "spomp1nare", "spompinare", "str0nz0", "str0nza", "str0nzo", "stronz0", "stronza", "stronzo", "stup1d", "stupid", "succh1am1", "succh1ami", "succhiam1", "succhiami", "sucker", "t0pa", "tapette", "test1c1e", "test1cle", "testic1e", "testicle", "tette", "topa", "tr01a", "tr0ia", "tr0mbare", "tr1ng1er", "tr1ngler", "tring1er", "tringler", "tro1a", "troia", "trombare", "turd", "twat", "vaffancu10", "vaffancu1o", "vaffancul0", "vaffanculo", "vag1na", "vagina", "verdammt", "verga", "w1chsen", "wank", "wichsen", "x0ch0ta", "x0chota", "xana", "xoch0ta", "xochota", "z0cc01a", "z0cc0la", "z0cco1a", "z0ccola", "z1z1", "z1zi", "ziz1", "zizi", "zocc01a", "zocc0la", "zocco1a", "zoccola" };
+///
+/// The words that are blocked by default, sorted.
+///
+constexpr std::array<std::string_view, 560> DEFAULT_BLOCKLIST_WORDS = { "0rgasm", "1d10t", "1d1ot", "1di0t", "1diot", "1eccacu10", "1eccacu1o", "1eccacul0", "1eccaculo", "1mbec11e", "1mbec1le", "1mbeci1e", "1mbecile", "a11upat0", "a11upato", "a1lupat0", "a1lupato", "aand", "ah01e", "ah0le", "aho1e", "ahole", "al1upat0", "al1upato", "allupat0", "allupato", "ana1", "ana1e", "anal", "anale", "anus", "arrapat0", "arrapato", "arsch", "arse", "ass", "b00b", "b00be", "b01ata", "b0ceta", "b0iata", "b0ob", "b0obe", "b0sta", "b1tch", "b1te", "b1tte", "ba1atkar", "balatkar", "bastard0", "bastardo", "batt0na", "battona", "bitch", "bite", "bitte", "bo0b", "bo0be", "bo1ata", "boceta", "boiata", "boob", "boobe", "bosta", "bran1age", "bran1er", "bran1ette", "bran1eur", "bran1euse", "branlage", "branler", "branlette", "branleur", "branleuse", "c0ck", "c0g110ne", "c0g11one", "c0g1i0ne", "c0g1ione", "c0gl10ne", "c0gl1one", "c0gli0ne", "c0glione", "c0na", "c0nnard", "c0nnasse", "c0nne", "c0u111es", "c0u11les", "c0u1l1es", "c0u1lles", "c0ui11es", "c0ui1les", "c0uil1es", "c0uilles", "c11t", "c11t0", "c11to", "c1it", "c1it0", "c1ito", "cabr0n", "cabra0", "cabrao", "cabron", "caca", "cacca", "cacete", "cagante", "cagar", "cagare", "cagna", "cara1h0", "cara1ho", "caracu10", "caracu1o", "caracul0", "caraculo", "caralh0", "caralho", "cazz0", "cazz1mma", "cazzata", "cazzimma", "cazzo", "ch00t1a", "ch00t1ya", "ch00tia", "ch00tiya", "ch0d", "ch0ot1a", "ch0ot1ya", "ch0otia", "ch0otiya", "ch1asse", "ch1avata", "ch1er", "ch1ng0", "ch1ngadaz0s", "ch1ngadazos", "ch1ngader1ta", "ch1ngaderita", "ch1ngar", "ch1ngo", "ch1ngues", "ch1nk", "chatte", "chiasse", "chiavata", "chier", "ching0", "chingadaz0s", "chingadazos", "chingader1ta", "chingaderita", "chingar", "chingo", "chingues", "chink", "cho0t1a", "cho0t1ya", "cho0tia", "cho0tiya", "chod", "choot1a", "choot1ya", "chootia", "chootiya", "cl1t", "cl1t0", "cl1to", "clit", "clit0", "clito", "cock", "cog110ne", "cog11one", "cog1i0ne", "cog1ione", "cogl10ne", "cogl1one", "cogli0ne", "coglione", "cona", "connard", "connasse", "conne", "cou111es", "cou11les", "cou1l1es", "cou1lles", "coui11es", "coui1les", "couil1es", "couilles", "cracker", "crap", "cu10", "cu1att0ne", "cu1attone", "cu1er0", "cu1ero", "cu1o", "cul0", "culatt0ne", "culattone", "culer0", "culero", "culo", "cum", "cunt", "d11d0", "d11do", "d1ck", "d1ld0", "d1ldo", "damn", "de1ch", "deich", "depp", "di1d0", "di1do", "dick", "dild0", "dildo", "dyke", "encu1e", "encule", "enema", "enf01re", "enf0ire", "enfo1re", "enfoire", "estup1d0", "estup1do", "estupid0", "estupido", "etr0n", "etron", "f0da", "f0der", "f0ttere", "f0tters1", "f0ttersi", "f0tze", "f0utre", "f1ca", "f1cker", "f1ga", "fag", "fica", "ficker", "figa", "foda", "foder", "fottere", "fotters1", "fottersi", "fotze", "foutre", "fr0c10", "fr0c1o", "fr0ci0", "fr0cio", "fr0sc10", "fr0sc1o", "fr0sci0", "fr0scio", "froc10", "froc1o", "froci0", "frocio", "frosc10", "frosc1o", "frosci0", "froscio", "fuck", "g00", "g0o", "g0u1ne", "g0uine", "gandu", "go0", "goo", "gou1ne", "gouine", "gr0gnasse", "grognasse", "haram1", "harami", "haramzade", "hund1n", "hundin", "id10t", "id1ot", "idi0t", "idiot", "imbec11e", "imbec1le", "imbeci1e", "imbecile", "j1zz", "jerk", "jizz", "k1ke", "kam1ne", "kamine", "kike", "leccacu10", "leccacu1o", "leccacul0", "leccaculo", "m1erda", "m1gn0tta", "m1gnotta", "m1nch1a", "m1nchia", "m1st", "mam0n", "mamahuev0", "mamahuevo", "mamon", "masturbat10n", "masturbat1on", "masturbate", "masturbati0n", "masturbation", "merd0s0", "merd0so", "merda", "merde", "merdos0", "merdoso", "mierda", "mign0tta", "mignotta", "minch1a", "minchia", "mist", "musch1", "muschi", "n1gger", "neger", "negr0", "negre", "negro", "nerch1a", "nerchia", "nigger", "orgasm", "p00p", "p011a", "p01la", "p0l1a", "p0lla", "p0mp1n0", "p0mp1no", "p0mpin0", "p0mpino", "p0op", "p0rca", "p0rn", "p0rra", "p0uff1asse", "p0uffiasse", "p1p1", "p1pi", "p1r1a", "p1rla", "p1sc10", "p1sc1o", "p1sci0", "p1scio", "p1sser", "pa11e", "pa1le", "pal1e", "palle", "pane1e1r0", "pane1e1ro", "pane1eir0", "pane1eiro", "panele1r0", "panele1ro", "paneleir0", "paneleiro", "patakha", "pec0r1na", "pec0rina", "pecor1na", "pecorina", "pen1s", "pendej0", "pendejo", "penis", "pip1", "pipi", "pir1a", "pirla", "pisc10", "pisc1o", "pisci0", "piscio", "pisser", "po0p", "po11a", "po1la", "pol1a", "polla", "pomp1n0", "pomp1no", "pompin0", "pompino", "poop", "porca", "porn", "porra", "pouff1asse", "pouffiasse", "pr1ck", "prick", "pussy", "put1za", "puta", "puta1n", "putain", "pute", "putiza", "puttana", "queca", "r0mp1ba11e", "r0mp1ba1le", "r0mp1bal1e", "r0mp1balle", "r0mpiba11e", "r0mpiba1le", "r0mpibal1e", "r0mpiballe", "rand1", "randi", "rape", "recch10ne", "recch1one", "recchi0ne", "recchione", "retard", "romp1ba11e", "romp1ba1le", "romp1bal1e", "romp1balle", "rompiba11e", "rompiba1le", "rompibal1e", "rompiballe", "ruff1an0", "ruff1ano", "ruffian0", "ruffiano", "s1ut", "sa10pe", "sa1aud", "sa1ope", "sacanagem", "sal0pe", "salaud", "salope", "saugnapf", "sb0rr0ne", "sb0rra", "sb0rrone", "sbattere", "sbatters1", "sbattersi", "sborr0ne", "sborra", "sborrone", "sc0pare", "sc0pata", "sch1ampe", "sche1se", "sche1sse", "scheise", "scheisse", "schlampe", "schwachs1nn1g", "schwachs1nnig", "schwachsinn1g", "schwachsinnig", "schwanz", "scopare", "scopata", "sexy", "sh1t", "shit", "slut", "sp0mp1nare", "sp0mpinare", "spomp1nare", "spompinare", "str0nz0", "str0nza", "str0nzo", "stronz0", "stronza", "stronzo", "stup1d", "stupid", "succh1am1", "succh1ami", "succhiam1", "succhiami", "sucker", "t0pa", "tapette", "test1c1e", "test1cle", "testic1e", "testicle", "tette", "topa", "tr01a", "tr0ia", "tr0mbare", "tr1ng1er", "tr1ngler", "tring1er", "tringler", "tro1a", "troia", "trombare", "turd", "twat", "vaffancu10", "vaffancu1o", "vaffancul0", "vaffanculo", "vag1na", "vagina", "verdammt", "verga", "w1chsen", "wank", "wichsen", "x0ch0ta", "x0chota", "xana", "xoch0ta", "xochota", "z0cc01a", "z0cc0la", "z0cco1a", "z0ccola", "z1z1", "z1zi", "ziz1", "zizi", "zocc01a", "zocc0la", "zocco1a", "zoccola" };
+
+///
+/// @return The words that are blocked by default, as a set. The set is built
+///         the first time it's needed, rather than when the program starts.
+///
+inline const std::set<std::string>& defaultBlocklist()
+{
+    static const std::set<std::string> words(DEFAULT_BLOCKLIST_WORDS.cbegin(), DEFAULT_BLOCKLIST_WORDS.cend());
+    return words;
 }
+
+///
+/// Stands in for the `const std::set<std::string>` that `DEFAULT_BLOCKLIST`
+/// used to be, forwarding to defaultBlocklist(), so that the set isn't built
+/// when the program starts. It converts to the set wherever one is expected.
+///
+struct DefaultBlocklistSet
+{
+    using const_iterator = std::set<std::string>::const_iterator;
+    using iterator = std::set<std::string>::iterator;
+    using value_type = std::string;
+
+    operator const std::set<std::string>&() const { return defaultBlocklist(); }
+
+    const_iterator begin() const { return defaultBlocklist().cbegin(); }
+    const_iterator end() const { return defaultBlocklist().cend(); }
+    const_iterator cbegin() const { return defaultBlocklist().cbegin(); }
+    const_iterator cend() const { return defaultBlocklist().cend(); }
+    const_iterator find(const std::string& word) const { return defaultBlocklist().find(word); }
+    size_t count(const std::string& word) const { return defaultBlocklist().count(word); }
+    size_t size() const { return defaultBlocklist().size(); }
+    bool empty() const { return defaultBlocklist().empty(); }
+};
+
+///
+/// The words that are blocked by default, as a set. New code can use
+/// `DEFAULT_BLOCKLIST_WORDS` or defaultBlocklist() directly.
+///
+inline constexpr DefaultBlocklistSet DEFAULT_BLOCKLIST{};
+
+///
+/// @class Blocklist
+///
+/// @brief A set of words that must never appear in IDs.
+///
+/// Behaves like the `std::set<std::string>` it replaces in SqidsOptions:
+/// it's constructed from a set, converts back to `const std::set<std::string>&`,
+/// and its insert() and erase() return what the set's do. Unlike a set, the
+/// default blocklist is never copied: Blocklist::defaults() refers to `DEFAULT_BLOCKLIST_WORDS`
+/// until it's modified. The matcher compiled from a blocklist depends only on
+/// its words and on the characters of the alphabet, so it is compiled once
+/// and shared by all instances using the same words and characters, for as
+/// long as one of them is alive. This holds for custom blocklists as well as
+/// for the default one. The default matcher is also kept for the life of the
+/// process, for up to `PINNED_DEFAULT_MATCHERS` sets of characters, so that
+/// creating an instance never compiles it again.
+///
+/// Very large blocklists can be compiled ahead of time instead, with the
+/// `sqids-blocklist` tool or BlocklistMatcher::serialize(), and used with
+/// Blocklist::load(). Such a blocklist has no words to iterate over, and
+/// can't be modified.
+///
+class Blocklist
+{
+public:
+    using const_iterator = std::set<std::string>::const_iterator;
+    using iterator = std::set<std::string>::iterator;
+    using value_type = std::string;
+
+    static constexpr size_t PINNED_DEFAULT_MATCHERS = 8;
+
+    Blocklist() = default;
+    Blocklist(std::initializer_list<std::string> words);
+    Blocklist(const std::set<std::string>& words);
+    Blocklist(std::set<std::string>&& words);
+    Blocklist(DefaultBlocklistSet);
+
+    static Blocklist defaults();
+    static Blocklist precompiled(std::shared_ptr<const BlocklistMatcher> matcher);
+    static Blocklist load(const std::string& path);
+
+    bool isDefault() const;
+    const std::shared_ptr<const BlocklistMatcher>& matcher() const;
+    const std::set<std::string>& words() const;
+    operator const std::set<std::string>&() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator find(const std::string& word) const;
+    size_t count(const std::string& word) const;
+    size_t size() const;
+    bool empty() const;
+
+    std::pair<iterator, bool> insert(std::string word);
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last);
+    size_t erase(const std::string& word);
+    void clear();
+
+    std::shared_ptr<const BlocklistMatcher> compile(const std::string& alphabet) const;
+
+private:
+    static std::string lowercaseString(std::string_view input);
+
+    template<typename Words>
+    static std::set<std::string> clean(const Words& words, const std::string& lowercaseAlphabet);
+
+    std::set<std::string>& mutableWords();
+
+    bool                  _default = false;
+    std::set<std::string> _words;
+
+    // Set for a precompiled blocklist
+    std::shared_ptr<const BlocklistMatcher> _matcher;
+};
+
+///
+/// Create a blocklist from a list of words.
+///
+inline Blocklist::Blocklist(std::initializer_list<std::string> words)
+  : _words(words)
+{
+}
+
+///
+/// @overload
+///
+inline Blocklist::Blocklist(const std::set<std::string>& words)
+  : _words(words)
+{
+}
+
+///
+/// @overload
+///
+inline Blocklist::Blocklist(std::set<std::string>&& words)
+  : _words(std::move(words))
+{
+}
+
+///
+/// The default blocklist, from `DEFAULT_BLOCKLIST`. Like defaults(), it isn't
+/// copied.
+///
+inline Blocklist::Blocklist(DefaultBlocklistSet)
+  : _default(true)
+{
+}
+
+///
+/// @return The default blocklist, without copying it
+///
+inline Blocklist Blocklist::defaults()
+{
+    Blocklist blocklist;
+    blocklist._default = true;
+    return blocklist;
+}
+
+///
+/// Use a blocklist that has already been compiled.
+///
+/// @param matcher  The compiled blocklist
+///
+inline Blocklist Blocklist::precompiled(std::shared_ptr<const BlocklistMatcher> matcher)
+{
+    Blocklist blocklist;
+    blocklist._matcher = std::move(matcher);
+    return blocklist;
+}
+
+///
+/// Load a blocklist compiled ahead of time. See BlocklistMatcher::load().
+///
+/// @throws std::runtime_error When the file can't be loaded
+///
+/// @param path  The file written by the `sqids-blocklist` tool
+///
+inline Blocklist Blocklist::load(const std::string& path)
+{
+    return precompiled(BlocklistMatcher::load(path));
+}
+
+///
+/// @return `true` if this is the default blocklist, unmodified
+///
+inline bool Blocklist::isDefault() const
+{
+    return _default;
+}
+
+///
+/// @return The matcher of a precompiled blocklist, or `nullptr`
+///
+inline const std::shared_ptr<const BlocklistMatcher>& Blocklist::matcher() const
+{
+    return _matcher;
+}
+
+///
+/// @return The words of the blocklist
+///
+inline const std::set<std::string>& Blocklist::words() const
+{
+    return _default ? defaultBlocklist() : _words;
+}
+
+///
+/// @return The words of the blocklist, like words()
+///
+inline Blocklist::operator const std::set<std::string>&() const
+{
+    return words();
+}
+
+inline Blocklist::const_iterator Blocklist::begin() const
+{
+    return words().cbegin();
+}
+
+inline Blocklist::const_iterator Blocklist::end() const
+{
+    return words().cend();
+}
+
+inline Blocklist::const_iterator Blocklist::find(const std::string& word) const
+{
+    return words().find(word);
+}
+
+inline size_t Blocklist::count(const std::string& word) const
+{
+    return words().count(word);
+}
+
+inline size_t Blocklist::size() const
+{
+    return words().size();
+}
+
+inline bool Blocklist::empty() const
+{
+    return words().empty();
+}
+
+inline std::pair<Blocklist::iterator, bool> Blocklist::insert(std::string word)
+{
+    return mutableWords().insert(std::move(word));
+}
+
+template<typename Iterator>
+void Blocklist::insert(Iterator first, Iterator last)
+{
+    mutableWords().insert(first, last);
+}
+
+inline size_t Blocklist::erase(const std::string& word)
+{
+    return mutableWords().erase(word);
+}
+
+inline void Blocklist::clear()
+{
+    _default = false;
+    _words.clear();
+    _matcher.reset();
+}
+
+///
+/// Compile the blocklist for an alphabet. Words with less than 3 characters,
+/// and words with characters that aren't in the alphabet, are left out.
+///
+/// @throws std::runtime_error When a precompiled blocklist was compiled for
+///                            an alphabet which lacks some of the characters
+///                            of `alphabet`
+///
+/// @param alphabet  The alphabet IDs are generated from
+/// @return          The matcher, shared with other instances using the same
+///                  words and characters
+///
+inline std::shared_ptr<const BlocklistMatcher> Blocklist::compile(const std::string& alphabet) const
+{
+    if (_matcher) {
+        if (!_matcher->supportsAlphabet(alphabet)) {
+            SQIDS_THROW(std::runtime_error("Blocklist was compiled for a different alphabet."));
+        }
+        return _matcher;
+    }
+
+    // Only the characters of the alphabet decide which words are kept
+    std::string lowercaseAlphabet = lowercaseString(alphabet);
+    std::sort(lowercaseAlphabet.begin(), lowercaseAlphabet.end());
+    lowercaseAlphabet.erase(std::unique(lowercaseAlphabet.begin(), lowercaseAlphabet.end()), lowercaseAlphabet.end());
+
+    // Matchers are cached by the characters of the alphabet, and by the words
+    // kept for custom blocklists. The map is keyed on a hash of those, and
+    // entries with the same hash are told apart by comparing them in full.
+    std::set<std::string> words;
+    if (!_default) {
+        words = clean(_words, lowercaseAlphabet);
+    }
+
+    size_t hash = _default ? 1 : 0;
+    const auto combine = [&hash](std::string_view field) {
+        hash ^= std::hash<std::string_view>()(field) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(lowercaseAlphabet);
+    for (const auto& word : words) {
+        combine(word);
+    }
+
+    struct CachedMatcher
+    {
+        bool                                  isDefault;
+        std::string                           alphabet;
+        std::set<std::string>                 words;
+        std::weak_ptr<const BlocklistMatcher> matcher;
+    };
+
+    static std::mutex mutex;
+    static std::unordered_multimap<size_t, CachedMatcher> matchers;
+    static size_t sweepSize = 16;
+
+    // Default matchers are kept even when no instance uses them, oldest
+    // dropped first
+    static std::deque<std::shared_ptr<const BlocklistMatcher>> pinned;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // The entry for these words and characters, if there is one
+    auto range = matchers.equal_range(hash);
+    auto found = std::find_if(range.first, range.second, [&](const auto& entry) {
+        const auto& cached = entry.second;
+        return cached.isDefault == _default && cached.alphabet == lowercaseAlphabet && cached.words == words;
+    });
+
+    if (found != range.second) {
+        if (auto matcher = found->second.matcher.lock()) {
+            return matcher;
+        }
+    }
+
+    // Compile the blocklist so that IDs can be checked in a single pass
+    std::shared_ptr<const BlocklistMatcher> matcher;
+    if (_default) {
+        matcher = std::make_shared<const BlocklistMatcher>(clean(DEFAULT_BLOCKLIST_WORDS, lowercaseAlphabet),
+                                                           lowercaseAlphabet);
+
+        pinned.push_back(matcher);
+        if (pinned.size() > PINNED_DEFAULT_MATCHERS) {
+            pinned.pop_front();
+        }
+    } else {
+        matcher = std::make_shared<const BlocklistMatcher>(words, lowercaseAlphabet);
+    }
+
+    if (found != range.second) {
+        found->second.matcher = matcher;
+        return matcher;
+    }
+
+    matchers.emplace(hash, CachedMatcher { _default, std::move(lowercaseAlphabet), std::move(words), matcher });
+
+    // Forget the matchers that are no longer used by any instance, once the
+    // map has doubled in size since it was last swept
+    if (matchers.size() >= sweepSize) {
+        for (auto it = matchers.begin(); it != matchers.end();) {
+            it = it->second.matcher.expired() ? matchers.erase(it) : std::next(it);
+        }
+        sweepSize = std::max<size_t>(16, matchers.size() * 2);
+    }
+
+    return matcher;
+}
+
+inline std::string Blocklist::lowercaseString(std::string_view input)
+{
+    std::string lowercaseString;
+    lowercaseString.resize(input.size());
+    std::transform(input.cbegin(), input.cend(), lowercaseString.begin(), ::tolower);
+    return lowercaseString;
+}
+
+template<typename Words>
+std::set<std::string> Blocklist::clean(const Words& words, const std::string& lowercaseAlphabet)
+{
+    // Clean up blocklist
+    std::set<std::string> blocklist;
+    for (std::string_view word : words) {
+        // 1. Remove words with less than 3 characters
+        if (word.size() < 3) {
+            continue;
+        }
+
+        const std::string lowercaseWord = lowercaseString(word);
+
+        // 2. Remove words that contain characters not in the alphabet
+        if (!std::all_of(lowercaseWord.cbegin(), lowercaseWord.cend(), [&lowercaseAlphabet](auto ch) {
+            return lowercaseAlphabet.find(ch) != std::string::npos;
+        })) {
+            continue;
+        }
+
+        // 3. Convert words to lowercase
+        blocklist.insert(lowercaseWord);
+    }
+
+    return blocklist;
+}
+
+inline std::set<std::string>& Blocklist::mutableWords()
+{
+    if (_matcher) {
+        SQIDS_THROW(std::runtime_error("A precompiled blocklist cannot be modified."));
+    }
+
+    // Copy the default blocklist before it's modified
+    if (_default) {
+        _words.insert(DEFAULT_BLOCKLIST_WORDS.cbegin(), DEFAULT_BLOCKLIST_WORDS.cend());
+        _default = false;
+    }
+
+    return _words;
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,345 @@
+///
+/// @file cache.hpp
+///
+/// Memoization of the IDs and numbers that are encoded and decoded most
+/// often, for traffic where a few entities account for most lookups.
+///
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "sqids.hpp"
+
+namespace sqidscxx
+{
+///
+/// @class CachedSqids
+///
+/// @brief Wraps a `Sqids` instance with bounded, thread-safe caches of
+///        numbers to IDs and IDs to numbers.
+///
+/// Entries are evicted with the CLOCK algorithm: a hit marks an entry as
+/// referenced, and eviction skips referenced entries once, clearing the mark.
+/// Hot entries stay cached while the rest are replaced in turn, without
+/// reordering a list on every hit. Each cache is split into shards, chosen
+/// by the hash of the key, which are locked independently so that threads
+/// rarely wait for each other.
+///
+/// The wrapper returns the same results as the instance it wraps, and throws
+/// the same exceptions; failures aren't cached. Instances that aren't
+/// wrapped are unaffected, and a capacity of 0 passes every call through.
+///
+/// Typical use:
+///
+/// @code
+/// static const sqidscxx::Sqids<> sqids;
+/// static sqidscxx::CachedSqids<> cached(sqids, 65536);
+///
+/// auto id = cached.encode({ tenant, row });
+/// @endcode
+///
+template<typename T = uint64_t>
+class CachedSqids
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "Numbers are cached by their bytes.");
+
+    struct Statistics
+    {
+        uint64_t encodeHits = 0;
+        uint64_t encodeMisses = 0;
+        uint64_t decodeHits = 0;
+        uint64_t decodeMisses = 0;
+        uint64_t evictions = 0;
+
+        // The number of cached IDs, in both directions
+        size_t size = 0;
+
+        double hitRate() const;
+    };
+
+    static constexpr size_t DEFAULT_SHARDS = 16;
+
+    CachedSqids(const Sqids<T>& sqids, size_t capacity, size_t shardCount = DEFAULT_SHARDS);
+
+    std::string encode(const std::vector<T>& numbers) const;
+    std::vector<T> decode(std::string_view id) const;
+
+    Statistics statistics() const;
+    void clear();
+
+    const Sqids<T>& sqids() const { return _sqids; }
+
+private:
+    // A CLOCK cache from byte strings to values, guarded by its own mutex.
+    // Keys are indexed by views into the slots holding them, so looking one
+    // up doesn't copy it; slots are kept in a deque, which never moves them.
+    template<typename Value>
+    struct alignas(64) Shard
+    {
+        struct Slot
+        {
+            std::string key;
+            Value value;
+            bool referenced;
+        };
+
+        bool find(std::string_view key, Value& value);
+        void insert(std::string_view key, const Value& value);
+        void clear();
+
+        std::mutex mutex;
+        std::deque<Slot> slots;
+        std::unordered_map<std::string_view, size_t> index;
+        size_t capacity = 0;
+        size_t hand = 0;
+
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    template<typename Value>
+    Shard<Value>& shard(const std::unique_ptr<Shard<Value>[]>& shards, std::string_view key) const;
+
+    const Sqids<T>& _sqids;
+    const size_t _shardCount;
+
+    mutable std::unique_ptr<Shard<std::string>[]> _encodeShards;
+    mutable std::unique_ptr<Shard<std::vector<T>>[]> _decodeShards;
+};
+
+///
+/// @param sqids       The instance to encode and decode with. It must outlive
+///                    the cache.
+/// @param capacity    The number of IDs to cache in each direction. Every
+///                    shard holds an equal part of it. 0 disables caching.
+/// @param shardCount  The number of independently locked parts of each cache
+///
+template<typename T>
+CachedSqids<T>::CachedSqids(const Sqids<T>& sqids, size_t capacity, size_t shardCount)
+  : _sqids(sqids),
+    _shardCount(capacity == 0 ? 0 : std::max<size_t>(1, std::min(shardCount, capacity)))
+{
+    if (_shardCount == 0) {
+        return;
+    }
+
+    _encodeShards = std::make_unique<Shard<std::string>[]>(_shardCount);
+    _decodeShards = std::make_unique<Shard<std::vector<T>>[]>(_shardCount);
+
+    // Spread the remainder of the capacity over the first shards
+    for (size_t i = 0; i < _shardCount; i++) {
+        const size_t shardCapacity = capacity / _shardCount + (i < capacity % _shardCount ? 1 : 0);
+        _encodeShards[i].capacity = shardCapacity;
+        _decodeShards[i].capacity = shardCapacity;
+    }
+}
+
+///
+/// Encode numbers into an ID, like Sqids::encode(), returning the cached ID
+/// if the same numbers were encoded before.
+///
+/// @throws std::runtime_error When encoding fails
+///
+template<typename T>
+std::string CachedSqids<T>::encode(const std::vector<T>& numbers) const
+{
+    if (_shardCount == 0 || numbers.empty()) {
+        return _sqids.encode(numbers);
+    }
+
+    const std::string_view key(reinterpret_cast<const char*>(numbers.data()), numbers.size() * sizeof(T));
+    auto& encodeShard = shard(_encodeShards, key);
+
+    std::string id;
+    if (encodeShard.find(key, id)) {
+        return id;
+    }
+
+    // find() and insert() lock the shard only while they touch it, so
+    // lookups of other keys in this shard go on while the ID is encoded. Two
+    // threads missing the same numbers both encode them; insert() keeps one.
+    id = _sqids.encode(numbers);
+    encodeShard.insert(key, id);
+
+    return id;
+}
+
+///
+/// Decode an ID, like Sqids::decode(), returning the cached numbers if the
+/// same ID was decoded before. IDs that decode to an empty sequence aren't
+/// cached, so that invalid IDs can't evict valid ones.
+///
+template<typename T>
+std::vector<T> CachedSqids<T>::decode(std::string_view id) const
+{
+    if (_shardCount == 0 || id.empty()) {
+        return _sqids.decode(id);
+    }
+
+    auto& decodeShard = shard(_decodeShards, id);
+
+    std::vector<T> numbers;
+    if (decodeShard.find(id, numbers)) {
+        return numbers;
+    }
+
+    numbers = _sqids.decode(id);
+    if (!numbers.empty()) {
+        decodeShard.insert(id, numbers);
+    }
+
+    return numbers;
+}
+
+///
+/// @return The counters of both caches, summed over all shards
+///
+template<typename T>
+typename CachedSqids<T>::Statistics CachedSqids<T>::statistics() const
+{
+    Statistics statistics;
+
+    for (size_t i = 0; i < _shardCount; i++) {
+        {
+            auto& shard = _encodeShards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            statistics.encodeHits += shard.hits;
+            statistics.encodeMisses += shard.misses;
+            statistics.evictions += shard.evictions;
+            statistics.size += shard.slots.size();
+        }
+        {
+            auto& shard = _decodeShards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            statistics.decodeHits += shard.hits;
+            statistics.decodeMisses += shard.misses;
+            statistics.evictions += shard.evictions;
+            statistics.size += shard.slots.size();
+        }
+    }
+
+    return statistics;
+}
+
+///
+/// Remove all cached IDs. The counters are kept.
+///
+template<typename T>
+void CachedSqids<T>::clear()
+{
+    for (size_t i = 0; i < _shardCount; i++) {
+        _encodeShards[i].clear();
+        _decodeShards[i].clear();
+    }
+}
+
+///
+/// @return The share of lookups in both directions that were hits, or 0
+///         before the first lookup
+///
+template<typename T>
+double CachedSqids<T>::Statistics::hitRate() const
+{
+    const uint64_t hits = encodeHits + decodeHits;
+    const uint64_t lookups = hits + encodeMisses + decodeMisses;
+
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+}
+
+template<typename T>
+template<typename Value>
+typename CachedSqids<T>::template Shard<Value>&
+CachedSqids<T>::shard(const std::unique_ptr<Shard<Value>[]>& shards, std::string_view key) const
+{
+    return shards[std::hash<std::string_view>()(key) % _shardCount];
+}
+
+///
+/// Look up `key`, marking its entry as referenced.
+///
+/// @return Whether `key` was found; if so, its value is copied to `value`
+///
+template<typename T>
+template<typename Value>
+bool CachedSqids<T>::Shard<Value>::find(std::string_view key, Value& value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+
+    Slot& slot = slots[it->second];
+    slot.referenced = true;
+    value = slot.value;
+    hits++;
+
+    return true;
+}
+
+///
+/// Add an entry, replacing the first entry after the hand that wasn't
+/// referenced since the hand last passed it.
+///
+template<typename T>
+template<typename Value>
+void CachedSqids<T>::Shard<Value>::insert(std::string_view key, const Value& value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Another thread may have added the same entry in the meantime
+    if (index.count(key) != 0) {
+        return;
+    }
+
+    size_t position;
+    if (slots.size() < capacity) {
+        position = slots.size();
+        slots.push_back(Slot { std::string(key), value, false });
+    } else {
+        while (slots[hand].referenced) {
+            slots[hand].referenced = false;
+            hand = (hand + 1 == slots.size()) ? 0 : hand + 1;
+        }
+
+        position = hand;
+        hand = (hand + 1 == slots.size()) ? 0 : hand + 1;
+
+        // The index refers to the key of the slot, so remove it before the
+        // key is replaced
+        Slot& slot = slots[position];
+        index.erase(slot.key);
+        slot.key.assign(key.data(), key.size());
+        slot.value = value;
+        slot.referenced = false;
+        evictions++;
+    }
+
+    index.emplace(slots[position].key, position);
+}
+
+template<typename T>
+template<typename Value>
+void CachedSqids<T>::Shard<Value>::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    index.clear();
+    slots.clear();
+    hand = 0;
+}
+
+} // namespace sqidscxx
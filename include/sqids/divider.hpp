@@ -0,0 +1,82 @@
+///
+/// @file divider.hpp
+///
+#pragma once
+
+#include <cstdint>
+
+namespace sqidscxx
+{
+///
+/// @class Divider
+///
+/// @brief Division of 64-bit unsigned integers by a divisor that is fixed at
+///        runtime, using a precomputed multiplicative inverse instead of a
+///        hardware division instruction.
+///
+/// This is the round-up method by Granlund and Montgomery, as used by
+/// libdivide: for a divisor `d` with `l = ceil(log2(d))`, the multiplier is
+/// `m = floor(2^64 * (2^l - d) / d) + 1`, and the quotient of `n` is
+/// `(t + ((n - t) >> 1)) >> (l - 1)` where `t` is the high half of `m * n`.
+///
+/// Requires a compiler with 128-bit integer support; otherwise, the regular
+/// division operator is used.
+///
+class Divider
+{
+public:
+    constexpr Divider() = default;
+    constexpr explicit Divider(uint64_t divisor);
+
+    constexpr uint64_t divisor() const { return _divisor; }
+
+    constexpr uint64_t divide(uint64_t n) const;
+    constexpr uint64_t remainder(uint64_t n) const;
+
+private:
+    uint64_t _divisor = 1;
+    uint64_t _multiplier = 0;
+    uint8_t  _shift = 0;
+};
+
+///
+/// @param divisor  The divisor, between 2 and 2^63
+///
+constexpr Divider::Divider(uint64_t divisor)
+  : _divisor(divisor)
+{
+    // `_shift` is ceil(log2(divisor)) - 1
+    uint8_t log = 0;
+    while ((uint64_t(1) << log) < divisor) {
+        log++;
+    }
+    _shift = log - 1;
+
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 numerator = static_cast<unsigned __int128>((uint64_t(1) << log) - divisor) << 64;
+    _multiplier = static_cast<uint64_t>(numerator / divisor) + 1;
+#endif
+}
+
+///
+/// @return `n / divisor()`
+///
+constexpr uint64_t Divider::divide(uint64_t n) const
+{
+#if defined(__SIZEOF_INT128__)
+    const uint64_t t = static_cast<uint64_t>((static_cast<unsigned __int128>(_multiplier) * n) >> 64);
+    return (t + ((n - t) >> 1)) >> _shift;
+#else
+    return n / _divisor;
+#endif
+}
+
+///
+/// @return `n % divisor()`
+///
+constexpr uint64_t Divider::remainder(uint64_t n) const
+{
+    return n - divide(n) * _divisor;
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,170 @@
+///
+/// @file error.hpp
+///
+/// Error codes for the non-throwing API, and error handling in builds
+/// without exceptions.
+///
+/// When exceptions are disabled (`-fno-exceptions`), every function that
+/// would throw prints the message of the exception and aborts instead. The
+/// `try` functions, such as Sqids::tryEncodeTo(), report errors as values
+/// and work the same in both builds.
+///
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define SQIDS_EXCEPTIONS 1
+#define SQIDS_THROW(exception) throw exception
+#else
+#define SQIDS_EXCEPTIONS 0
+#define SQIDS_THROW(exception) ::sqidscxx::abortWithError((exception).what())
+#endif
+
+namespace sqidscxx
+{
+///
+/// The reasons why encoding or decoding fails.
+///
+enum class Error : uint8_t
+{
+    None,              // No error
+    OutOfRange,        // A number is negative or greater than `maxValue`
+    MaxAttempts,       // Every attempt to generate the ID contained a blocked word
+    BufferTooSmall,    // The output buffer is too small for the ID
+    EmptyId,           // The ID is empty
+    InvalidCharacter,  // The ID contains a character that isn't in the alphabet
+    NonCanonical       // The ID isn't the one encode() generates for its numbers
+};
+
+///
+/// @return A description of `error`, which is a string literal
+///
+constexpr const char* errorMessage(Error error)
+{
+    switch (error) {
+        case Error::None:
+            return "No error.";
+        case Error::OutOfRange:
+            return "Number is out of the range that can be encoded.";
+        case Error::MaxAttempts:
+            return "Reached max attempts to re-generate the ID.";
+        case Error::BufferTooSmall:
+            return "Output buffer is too small for the ID.";
+        case Error::EmptyId:
+            return "The ID is empty.";
+        case Error::InvalidCharacter:
+            return "The ID contains a character that isn't in the alphabet.";
+        case Error::NonCanonical:
+            return "The ID isn't the one generated for its numbers.";
+    }
+    return "Unknown error.";
+}
+
+///
+/// Print `message` and abort; used instead of throwing when exceptions are
+/// disabled.
+///
+[[noreturn]] inline void abortWithError(const char* message)
+{
+    std::fprintf(stderr, "sqids: %s\n", message);
+    std::abort();
+}
+
+///
+/// @class Result
+///
+/// @brief Either a value, or the reason why there is none, in the style of
+///        `std::expected`. Creating a result with an error never allocates
+///        memory.
+///
+/// @code
+/// char buffer[64];
+/// auto length = sqids.tryEncodeTo(numbers, 2, buffer, sizeof(buffer));
+/// if (!length) {
+///     log(sqidscxx::errorMessage(length.error()));
+/// }
+/// @endcode
+///
+template<typename V>
+class Result
+{
+public:
+    constexpr Result(V value) : _value(std::move(value)), _error(Error::None) {}
+    constexpr Result(Error error) : _value(), _error(error) {}
+
+    constexpr bool has_value() const { return _error == Error::None; }
+    constexpr explicit operator bool() const { return has_value(); }
+
+    constexpr Error error() const { return _error; }
+
+    constexpr const V& value() const&;
+    constexpr V& value() &;
+    constexpr V&& value() &&;
+
+    constexpr const V& operator*() const& { return _value; }
+    constexpr V& operator*() & { return _value; }
+    constexpr V&& operator*() && { return std::move(_value); }
+
+    constexpr const V* operator->() const { return &_value; }
+    constexpr V* operator->() { return &_value; }
+
+    template<typename U>
+    constexpr V value_or(U&& fallback) const&;
+
+private:
+    V _value;
+    Error _error;
+};
+
+///
+/// @throws std::runtime_error When there is no value
+///
+template<typename V>
+constexpr const V& Result<V>::value() const&
+{
+    if (!has_value()) {
+        SQIDS_THROW(std::runtime_error(errorMessage(_error)));
+    }
+    return _value;
+}
+
+///
+/// @overload
+///
+template<typename V>
+constexpr V& Result<V>::value() &
+{
+    if (!has_value()) {
+        SQIDS_THROW(std::runtime_error(errorMessage(_error)));
+    }
+    return _value;
+}
+
+///
+/// @overload
+///
+template<typename V>
+constexpr V&& Result<V>::value() &&
+{
+    if (!has_value()) {
+        SQIDS_THROW(std::runtime_error(errorMessage(_error)));
+    }
+    return std::move(_value);
+}
+
+///
+/// @return The value, or `fallback` if there is none
+///
+template<typename V>
+template<typename U>
+constexpr V Result<V>::value_or(U&& fallback) const&
+{
+    return has_value() ? _value : static_cast<V>(std::forward<U>(fallback));
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,273 @@
+///
+/// @file fixed.hpp
+///
+/// Instances for alphabets that are known at compile time.
+///
+/// The alphabet is given as a type with a `static constexpr std::string_view`
+/// member named `value`:
+///
+/// @code
+/// struct Base36
+/// {
+///     static constexpr std::string_view value = "0123456789abcdefghijklmnopqrstuvwxyz";
+/// };
+///
+/// sqidscxx::FixedSqids<Base36, 8> sqids;
+/// auto id = sqids.encode({ 1, 2, 3 });
+/// @endcode
+///
+/// The alphabet is validated, shuffled and indexed by the compiler, so an
+/// invalid alphabet is a compile error rather than an exception. The
+/// compiler also builds the lookup tables, the dividers and digit counts,
+/// and the alphabet re-arranged for every offset, which encoding and decoding
+/// start from instead of re-arranging it on every call. None of this is
+/// computed when an instance is constructed.
+///
+/// The blocklist matcher is compiled at runtime, since it's built on the
+/// heap. The default one is looked up once for every FixedSqids type, and
+/// shared with all other instances whose alphabets use the same characters
+/// (see Blocklist).
+///
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "sqids.hpp"
+
+namespace sqidscxx
+{
+///
+/// The default alphabet, for use with FixedSqids.
+///
+struct DefaultAlphabet
+{
+    static constexpr std::string_view value = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+};
+
+///
+/// @class FixedAlphabet
+///
+/// @brief The tables Sqids builds from an alphabet, computed at compile time.
+///
+template<typename Alphabet>
+class FixedAlphabet
+{
+public:
+    static constexpr std::string_view source = Alphabet::value;
+    static constexpr size_t size = source.size();
+
+    static_assert(size >= 3, "Alphabet length must be at least 3.");
+
+private:
+    static constexpr bool containsMultibyteCharacters()
+    {
+        for (char ch : source) {
+            if ((static_cast<unsigned char>(ch) >> 7) == 1) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr bool containsDuplicateCharacters()
+    {
+        bool seen[256] = {};
+        for (char ch : source) {
+            if (seen[static_cast<unsigned char>(ch)]) {
+                return true;
+            }
+            seen[static_cast<unsigned char>(ch)] = true;
+        }
+        return false;
+    }
+
+    static_assert(!containsMultibyteCharacters(), "Alphabet cannot contain multibyte characters.");
+    static_assert(!containsDuplicateCharacters(), "Alphabet must not contain duplicate characters.");
+
+    // The same shuffle as Sqids::shuffle()
+    static constexpr std::array<char, size> shuffle()
+    {
+        std::array<char, size> alphabet = {};
+        for (size_t i = 0; i < size; i++) {
+            alphabet[i] = source[i];
+        }
+
+        for (unsigned int i = 0, j = size - 1; j > 0; i++, j--) {
+            const auto r = (i * j + alphabet[i] + alphabet[j]) % size;
+            const char ch = alphabet[i];
+            alphabet[i] = alphabet[r];
+            alphabet[r] = ch;
+        }
+
+        return alphabet;
+    }
+
+    static constexpr std::array<uint8_t, 256> indexAlphabet(const std::array<char, size>& alphabet)
+    {
+        std::array<uint8_t, 256> index = {};
+        for (size_t i = 0; i < index.size(); i++) {
+            index[i] = AlphabetLookup::NOT_IN_ALPHABET;
+        }
+        for (size_t i = 0; i < size; i++) {
+            index[static_cast<unsigned char>(alphabet[i])] = static_cast<uint8_t>(i);
+        }
+        return index;
+    }
+
+    // The same re-arrangement as Sqids::WorkingAlphabet: for every offset,
+    // the characters before it reversed, followed by the rest reversed
+    static constexpr std::array<char, size * size> rotate(const std::array<char, size>& alphabet)
+    {
+        std::array<char, size * size> rotations = {};
+        for (size_t offset = 0; offset < size; offset++) {
+            char* const rotation = &rotations[offset * size];
+            for (size_t i = 0; i < offset; i++) {
+                rotation[i] = alphabet[offset - 1 - i];
+            }
+            for (size_t i = offset; i < size; i++) {
+                rotation[i] = alphabet[size - 1 - (i - offset)];
+            }
+        }
+        return rotations;
+    }
+
+    static constexpr std::array<uint8_t, size * size> locate(const std::array<char, size * size>& rotations,
+                                                             const std::array<uint8_t, 256>& index)
+    {
+        std::array<uint8_t, size * size> positions = {};
+        for (size_t offset = 0; offset < size; offset++) {
+            for (size_t i = 0; i < size; i++) {
+                const auto ch = static_cast<unsigned char>(rotations[offset * size + i]);
+                positions[offset * size + index[ch]] = static_cast<uint8_t>(i);
+            }
+        }
+        return positions;
+    }
+
+    // The largest power of the number of digits below 2^32, as in
+    // Sqids::initialize()
+    static constexpr std::pair<uint64_t, size_t> chunk()
+    {
+        uint64_t chunk = size - 1;
+        size_t digits = 1;
+        while (chunk * (size - 1) < (uint64_t(1) << 32)) {
+            chunk *= size - 1;
+            digits++;
+        }
+        return { chunk, digits };
+    }
+
+public:
+    ///
+    /// The alphabet after the initial shuffle.
+    ///
+    static constexpr std::array<char, size> chars = shuffle();
+
+    ///
+    /// The position of every byte in `chars`, or `AlphabetLookup::NOT_IN_ALPHABET`.
+    ///
+    static constexpr std::array<uint8_t, 256> index = indexAlphabet(chars);
+
+    ///
+    /// The same positions, as looked up while validating IDs.
+    ///
+    static constexpr AlphabetLookup lookup = AlphabetLookup(index);
+
+    ///
+    /// `chars` re-arranged for every offset, one after the other.
+    ///
+    static constexpr std::array<char, size * size> rotations = rotate(chars);
+
+    ///
+    /// The position of every character in each of the `rotations`, indexed
+    /// by its position in `chars`.
+    ///
+    static constexpr std::array<uint8_t, size * size> positions = locate(rotations, index);
+
+    ///
+    /// All of the above, for the Sqids constructor.
+    ///
+    static constexpr AlphabetTables tables = { std::string_view(chars.data(), size), &index, &lookup,
+                                               rotations.data(), positions.data(), Divider(size),
+                                               Divider(size - 1), Divider(chunk().first), chunk().second };
+};
+
+///
+/// @class FixedSqids
+///
+/// @brief A Sqids instance whose alphabet and minimum length are fixed at
+///        compile time.
+///
+/// Encodes and decodes exactly like `Sqids<T>` constructed with the same
+/// alphabet and minimum length.
+///
+/// `IntegerTraits<T>` must be usable in constant expressions, as it is for
+/// built-in integers and BigUint.
+///
+/// @tparam Alphabet   A type with a `static constexpr std::string_view value`
+/// @tparam MinLength  The minimum length of IDs
+/// @tparam T          The type of the integers to encode
+///
+template<typename Alphabet = DefaultAlphabet, uint8_t MinLength = 0, typename T = uint64_t>
+class FixedSqids : public Sqids<T>
+{
+public:
+    explicit FixedSqids(const Blocklist& blocklist = Blocklist::defaults(), uint8_t alphabetCacheDepth = 0,
+                        bool canonicalDecoding = false);
+
+    ///
+    /// @return The alphabet after the initial shuffle
+    ///
+    static constexpr std::string_view alphabet()
+    {
+        return std::string_view(FixedAlphabet<Alphabet>::chars.data(), FixedAlphabet<Alphabet>::size);
+    }
+
+    static constexpr uint8_t minLength = MinLength;
+
+private:
+    // The number of digits of the largest number
+    static constexpr size_t maxDigits()
+    {
+        size_t digits = 0;
+        for (T v = Sqids<T>::maxValue; !IntegerTraits<T>::isZero(v);
+             IntegerTraits<T>::divide(v, FixedAlphabet<Alphabet>::tables.digitDivider)) {
+            digits++;
+        }
+        return digits;
+    }
+
+    static std::shared_ptr<const BlocklistMatcher> compile(const Blocklist& blocklist);
+};
+
+///
+/// @param blocklist           Words that must never appear in IDs
+/// @param alphabetCacheDepth  See SqidsOptions::alphabetCacheDepth
+/// @param canonicalDecoding   See SqidsOptions::canonicalDecoding
+///
+template<typename Alphabet, uint8_t MinLength, typename T>
+FixedSqids<Alphabet, MinLength, T>::FixedSqids(const Blocklist& blocklist, uint8_t alphabetCacheDepth,
+                                               bool canonicalDecoding)
+  : Sqids<T>(FixedAlphabet<Alphabet>::tables, std::integral_constant<size_t, maxDigits()>::value, compile(blocklist),
+             SqidsOptions { "", MinLength, {}, alphabetCacheDepth, canonicalDecoding })
+{
+}
+
+template<typename Alphabet, uint8_t MinLength, typename T>
+std::shared_ptr<const BlocklistMatcher> FixedSqids<Alphabet, MinLength, T>::compile(const Blocklist& blocklist)
+{
+    // Skips the cache lookup of Blocklist::compile() for every instance after
+    // the first
+    if (blocklist.isDefault()) {
+        static const auto matcher = blocklist.compile(std::string(alphabet()));
+        return matcher;
+    }
+
+    return blocklist.compile(std::string(alphabet()));
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,189 @@
+///
+/// @file instrumentation.hpp
+///
+/// Optional counters and hooks for encoding and decoding.
+///
+/// Instrumentation is compiled in only when `SQIDS_INSTRUMENTATION` is
+/// defined (the `SQIDS_INSTRUMENTATION` CMake option defines it). Otherwise,
+/// none of the hooks are called and there is no overhead at all. Every
+/// translation unit of a program must agree on the definition.
+///
+/// Events are delivered to the sink installed with setInstrumentationSink().
+/// Sinks are called from whichever thread encodes or decodes, so they must
+/// be thread-safe.
+///
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(SQIDS_INSTRUMENTATION)
+#define SQIDS_INSTRUMENT(...)                                          \
+    do {                                                               \
+        if (auto* sink_ = ::sqidscxx::instrumentationSink()) {         \
+            sink_->__VA_ARGS__;                                        \
+        }                                                              \
+    } while (false)
+#else
+#define SQIDS_INSTRUMENT(...) \
+    do {                      \
+    } while (false)
+#endif
+
+namespace sqidscxx
+{
+///
+/// The reasons why an ID decodes to an empty sequence.
+///
+enum class DecodeRejection
+{
+    EmptyId,           // The ID is empty
+    InvalidCharacter,  // The ID contains a character that isn't in the alphabet
+    NonCanonical,      // The ID isn't canonical, and canonical decoding is on
+    Count
+};
+
+///
+/// @class InstrumentationSink
+///
+/// @brief Receives encoding and decoding events. All functions do nothing by
+///        default; override the ones needed.
+///
+class InstrumentationSink
+{
+public:
+    virtual ~InstrumentationSink() = default;
+
+    ///
+    /// An ID was generated.
+    ///
+    /// @param count          The number of integers in the ID
+    /// @param increments     How many times the ID was re-generated because
+    ///                       it contained a blocked word
+    /// @param blocklistTime  The time spent checking for blocked words
+    ///
+    virtual void encoded(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime)
+    {
+        (void)count;
+        (void)increments;
+        (void)blocklistTime;
+    }
+
+    ///
+    /// Every attempt to generate an ID contained a blocked word, and encoding
+    /// failed.
+    ///
+    virtual void encodeFailed(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime)
+    {
+        (void)count;
+        (void)increments;
+        (void)blocklistTime;
+    }
+
+    ///
+    /// An ID was decoded into `count` integers. Every decoding call reports
+    /// one event; IDs decoded lazily report the integers that were read.
+    ///
+    virtual void decoded(size_t count)
+    {
+        (void)count;
+    }
+
+    ///
+    /// An ID was rejected, and decoded into an empty sequence.
+    ///
+    virtual void decodeRejected(DecodeRejection reason)
+    {
+        (void)reason;
+    }
+};
+
+///
+/// @class CountingSink
+///
+/// @brief A sink which keeps counters of all events, to be read periodically
+///        and passed on to a metrics system.
+///
+class CountingSink : public InstrumentationSink
+{
+public:
+    // Bucket `i` counts the IDs that took `i` increments; the last bucket
+    // counts all IDs that took more
+    static constexpr size_t INCREMENT_BUCKETS = 8;
+
+    void encoded(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime) override;
+    void encodeFailed(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime) override;
+    void decoded(size_t count) override;
+    void decodeRejected(DecodeRejection reason) override;
+
+    std::atomic<uint64_t> encodes { 0 };
+    std::atomic<uint64_t> encodeFailures { 0 };
+    std::atomic<uint64_t> regenerations { 0 };
+    std::array<std::atomic<uint64_t>, INCREMENT_BUCKETS> increments {};
+    std::atomic<uint64_t> blocklistNanoseconds { 0 };
+
+    std::atomic<uint64_t> decodes { 0 };
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(DecodeRejection::Count)> rejections {};
+};
+
+inline std::atomic<InstrumentationSink*>& instrumentationSinkStorage()
+{
+    static std::atomic<InstrumentationSink*> sink { nullptr };
+    return sink;
+}
+
+///
+/// Install the sink that receives all events, replacing the previous one.
+/// Pass `nullptr` to stop receiving events. The sink must stay alive until
+/// it has been replaced and all encoding and decoding calls started before
+/// have returned.
+///
+inline void setInstrumentationSink(InstrumentationSink* sink)
+{
+    instrumentationSinkStorage().store(sink, std::memory_order_release);
+}
+
+///
+/// @return The installed sink, or `nullptr`
+///
+inline InstrumentationSink* instrumentationSink()
+{
+    return instrumentationSinkStorage().load(std::memory_order_acquire);
+}
+
+inline void CountingSink::encoded(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime)
+{
+    (void)count;
+
+    encodes.fetch_add(1, std::memory_order_relaxed);
+    regenerations.fetch_add(increments, std::memory_order_relaxed);
+    this->increments[std::min<size_t>(increments, INCREMENT_BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    blocklistNanoseconds.fetch_add(blocklistTime.count(), std::memory_order_relaxed);
+}
+
+inline void CountingSink::encodeFailed(size_t count, unsigned int increments, std::chrono::nanoseconds blocklistTime)
+{
+    (void)count;
+
+    encodeFailures.fetch_add(1, std::memory_order_relaxed);
+    regenerations.fetch_add(increments, std::memory_order_relaxed);
+    blocklistNanoseconds.fetch_add(blocklistTime.count(), std::memory_order_relaxed);
+}
+
+inline void CountingSink::decoded(size_t count)
+{
+    (void)count;
+
+    decodes.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingSink::decodeRejected(DecodeRejection reason)
+{
+    decodes.fetch_add(1, std::memory_order_relaxed);
+    rejections[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace sqidscxx
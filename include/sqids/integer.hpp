@@ -0,0 +1,402 @@
+///
+/// @file integer.hpp
+///
+/// The arithmetic Sqids needs on the integers it encodes, for built-in
+/// integers, `unsigned __int128` and fixed-width integers of any size.
+///
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include "divider.hpp"
+
+namespace sqidscxx
+{
+///
+/// @class BigUint
+///
+/// @brief An unsigned integer of `Bits` bits, stored as 64-bit limbs, least
+///        significant limb first.
+///
+/// It supports what's needed to encode and decode IDs: construction,
+/// comparison and conversion to decimal. For example, a UUID can be encoded
+/// as a `BigUint<128>` built from its two halves:
+///
+/// @code
+/// sqidscxx::Sqids<sqidscxx::BigUint<128>> sqids;
+/// auto id = sqids.encode({ sqidscxx::BigUint<128>({ low, high }) });
+/// @endcode
+///
+template<size_t Bits>
+class BigUint
+{
+public:
+    static_assert(Bits > 0 && Bits % 64 == 0, "The width of a BigUint must be a multiple of 64 bits.");
+
+    static constexpr size_t LIMBS = Bits / 64;
+
+    constexpr BigUint() = default;
+    constexpr BigUint(uint64_t value) : limbs { value } {}
+    constexpr explicit BigUint(const std::array<uint64_t, LIMBS>& _limbs) : limbs(_limbs) {}
+
+    static constexpr BigUint max();
+
+    std::string toString() const;
+
+    std::array<uint64_t, LIMBS> limbs {};
+};
+
+///
+/// @struct LimbArithmetic
+///
+/// @brief Arithmetic between an unsigned integer stored as 64-bit limbs,
+///        least significant first, and a small number.
+///
+/// Dividing by the length of an alphabet never needs a wide division: every
+/// limb is divided in two 32-bit halves, each prefixed with the remainder so
+/// far, which fits into 64 bits as long as the divisor is below 2^32. This
+/// takes two multiplications per limb with a precomputed Divider, instead of
+/// a call to a 128-bit division routine per digit.
+///
+struct LimbArithmetic
+{
+    static constexpr uint64_t divide(uint64_t* limbs, size_t count, const Divider& divider);
+    static constexpr uint64_t remainder(const uint64_t* limbs, size_t count, const Divider& divider);
+    static constexpr void multiplyAdd(uint64_t* limbs, size_t count, uint64_t factor, uint64_t addend);
+    static constexpr bool isZero(const uint64_t* limbs, size_t count);
+    static std::string toString(uint64_t* limbs, size_t count);
+};
+
+///
+/// Divide a number in place.
+///
+/// @param limbs    The number, which receives the quotient
+/// @param count    The number of limbs
+/// @param divider  The divisor, below 2^32
+/// @return         The remainder
+///
+constexpr uint64_t LimbArithmetic::divide(uint64_t* limbs, size_t count, const Divider& divider)
+{
+    const uint64_t divisor = divider.divisor();
+
+    // Leading zero limbs stay zero, and leave no remainder
+    size_t i = count;
+    while (i > 0 && limbs[i - 1] == 0) {
+        i--;
+    }
+    if (i == 0) {
+        return 0;
+    }
+
+    // Nothing is carried into the most significant limb, so it's divided
+    // in one go
+    uint64_t quotient = divider.divide(limbs[--i]);
+    uint64_t remainder = limbs[i] - quotient * divisor;
+    limbs[i] = quotient;
+
+    while (i-- > 0) {
+        const uint64_t high = (remainder << 32) | (limbs[i] >> 32);
+        const uint64_t highQuotient = divider.divide(high);
+        remainder = high - highQuotient * divisor;
+
+        const uint64_t low = (remainder << 32) | (limbs[i] & 0xFFFFFFFF);
+        const uint64_t lowQuotient = divider.divide(low);
+        remainder = low - lowQuotient * divisor;
+
+        limbs[i] = (highQuotient << 32) | lowQuotient;
+    }
+
+    return remainder;
+}
+
+///
+/// @return The remainder of dividing a number by a divisor below 2^32
+///
+constexpr uint64_t LimbArithmetic::remainder(const uint64_t* limbs, size_t count, const Divider& divider)
+{
+    uint64_t remainder = 0;
+
+    for (size_t i = count; i-- > 0;) {
+        remainder = divider.remainder((remainder << 32) | (limbs[i] >> 32));
+        remainder = divider.remainder((remainder << 32) | (limbs[i] & 0xFFFFFFFF));
+    }
+
+    return remainder;
+}
+
+///
+/// Compute `number * factor + addend` in place, dropping the bits that don't
+/// fit, like unsigned arithmetic does. Both `factor` and `addend` must be
+/// below 2^32.
+///
+constexpr void LimbArithmetic::multiplyAdd(uint64_t* limbs, size_t count, uint64_t factor, uint64_t addend)
+{
+    uint64_t carry = addend;
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t low = (limbs[i] & 0xFFFFFFFF) * factor + carry;
+        const uint64_t high = (limbs[i] >> 32) * factor + (low >> 32);
+
+        limbs[i] = (high << 32) | (low & 0xFFFFFFFF);
+        carry = high >> 32;
+    }
+}
+
+constexpr bool LimbArithmetic::isZero(const uint64_t* limbs, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (limbs[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+///
+/// @return The decimal digits of a number, which is overwritten
+///
+inline std::string LimbArithmetic::toString(uint64_t* limbs, size_t count)
+{
+    constexpr Divider ten(10);
+
+    std::string digits;
+    do {
+        digits.push_back(static_cast<char>('0' + divide(limbs, count, ten)));
+    } while (!isZero(limbs, count));
+
+    std::reverse(digits.begin(), digits.end());
+
+    return digits;
+}
+
+///
+/// @return The largest value of the type
+///
+template<size_t Bits>
+constexpr BigUint<Bits> BigUint<Bits>::max()
+{
+    BigUint value;
+    for (auto& limb : value.limbs) {
+        limb = UINT64_MAX;
+    }
+    return value;
+}
+
+///
+/// @return The number in decimal
+///
+template<size_t Bits>
+std::string BigUint<Bits>::toString() const
+{
+    auto copy = limbs;
+    return LimbArithmetic::toString(copy.data(), LIMBS);
+}
+
+template<size_t Bits>
+constexpr bool operator==(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    for (size_t i = 0; i < BigUint<Bits>::LIMBS; i++) {
+        if (a.limbs[i] != b.limbs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<size_t Bits>
+constexpr bool operator!=(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    return !(a == b);
+}
+
+template<size_t Bits>
+constexpr bool operator<(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    for (size_t i = BigUint<Bits>::LIMBS; i-- > 0;) {
+        if (a.limbs[i] != b.limbs[i]) {
+            return a.limbs[i] < b.limbs[i];
+        }
+    }
+    return false;
+}
+
+template<size_t Bits>
+constexpr bool operator>(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    return b < a;
+}
+
+template<size_t Bits>
+constexpr bool operator<=(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    return !(b < a);
+}
+
+template<size_t Bits>
+constexpr bool operator>=(const BigUint<Bits>& a, const BigUint<Bits>& b)
+{
+    return !(a < b);
+}
+
+template<size_t Bits>
+std::ostream& operator<<(std::ostream& stream, const BigUint<Bits>& value)
+{
+    return stream << value.toString();
+}
+
+///
+/// @struct IntegerTraits
+///
+/// @brief The operations Sqids performs on integers of type `T`. Divisors
+///        and factors are the length of an alphabet, so they are small.
+///
+/// Specializations are provided for built-in integers of up to 64 bits,
+/// `unsigned __int128` where the compiler supports it, and BigUint. Other
+/// integer types can be encoded by specializing this template; types stored
+/// as 64-bit limbs can use LimbArithmetic. The members are:
+///
+///   - `max()`: the largest value that can be encoded
+///   - `isNegative(n)`: whether `n` is out of range because it's negative
+///   - `isZero(n)`
+///   - `toUint64(n, value)`: stores `n` in `value` and returns `true` if it
+///     fits into 64 bits; the rest of `n` is then converted without it
+///   - `remainder(n, divider)`: `n % divider.divisor()`
+///   - `divide(n, divider)`: divides `n` in place and returns the remainder
+///   - `multiplyAdd(n, factor, addend)`: `n = n * factor + addend`
+///   - `toString(n)`: `n` in decimal, for error messages
+///
+template<typename T, typename Enable = void>
+struct IntegerTraits;
+
+///
+/// Built-in integers of up to 64 bits, using the Divider directly.
+///
+template<typename T>
+struct IntegerTraits<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)>>
+{
+    static constexpr T max() { return std::numeric_limits<T>::max(); }
+
+    static constexpr bool isNegative(T n)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            return n < 0;
+        } else {
+            (void)n;
+            return false;
+        }
+    }
+
+    static constexpr bool isZero(T n) { return n == 0; }
+
+    static constexpr bool toUint64(T n, uint64_t& value)
+    {
+        value = static_cast<uint64_t>(n);
+        return true;
+    }
+
+    static constexpr uint64_t remainder(T n, const Divider& divider)
+    {
+        return divider.remainder(static_cast<uint64_t>(n));
+    }
+
+    static constexpr uint64_t divide(T& n, const Divider& divider)
+    {
+        const uint64_t value = static_cast<uint64_t>(n);
+        const uint64_t quotient = divider.divide(value);
+        n = static_cast<T>(quotient);
+        return value - quotient * divider.divisor();
+    }
+
+    static constexpr void multiplyAdd(T& n, uint64_t factor, uint64_t addend)
+    {
+        n = static_cast<T>(n * factor + addend);
+    }
+
+    static std::string toString(T n) { return std::to_string(n); }
+};
+
+#if defined(__SIZEOF_INT128__)
+///
+/// `unsigned __int128`, divided as two limbs; multiplication is native.
+///
+template<>
+struct IntegerTraits<unsigned __int128>
+{
+    using Type = unsigned __int128;
+
+    static constexpr Type max() { return ~Type(0); }
+    static constexpr bool isNegative(Type) { return false; }
+    static constexpr bool isZero(Type n) { return n == 0; }
+
+    static constexpr bool toUint64(Type n, uint64_t& value)
+    {
+        value = static_cast<uint64_t>(n);
+        return (n >> 64) == 0;
+    }
+
+    static constexpr uint64_t remainder(Type n, const Divider& divider)
+    {
+        const uint64_t limbs[2] = { static_cast<uint64_t>(n), static_cast<uint64_t>(n >> 64) };
+        return LimbArithmetic::remainder(limbs, 2, divider);
+    }
+
+    static constexpr uint64_t divide(Type& n, const Divider& divider)
+    {
+        uint64_t limbs[2] = { static_cast<uint64_t>(n), static_cast<uint64_t>(n >> 64) };
+        const uint64_t remainder = LimbArithmetic::divide(limbs, 2, divider);
+        n = (Type(limbs[1]) << 64) | limbs[0];
+        return remainder;
+    }
+
+    static constexpr void multiplyAdd(Type& n, uint64_t factor, uint64_t addend) { n = n * factor + addend; }
+
+    static std::string toString(Type n)
+    {
+        uint64_t limbs[2] = { static_cast<uint64_t>(n), static_cast<uint64_t>(n >> 64) };
+        return LimbArithmetic::toString(limbs, 2);
+    }
+};
+#endif
+
+///
+/// BigUint, using LimbArithmetic.
+///
+template<size_t Bits>
+struct IntegerTraits<BigUint<Bits>>
+{
+    using Type = BigUint<Bits>;
+
+    static constexpr Type max() { return Type::max(); }
+    static constexpr bool isNegative(const Type&) { return false; }
+    static constexpr bool isZero(const Type& n) { return LimbArithmetic::isZero(n.limbs.data(), Type::LIMBS); }
+
+    static constexpr bool toUint64(const Type& n, uint64_t& value)
+    {
+        value = n.limbs[0];
+        return LimbArithmetic::isZero(n.limbs.data() + 1, Type::LIMBS - 1);
+    }
+
+    static constexpr uint64_t remainder(const Type& n, const Divider& divider)
+    {
+        return LimbArithmetic::remainder(n.limbs.data(), Type::LIMBS, divider);
+    }
+
+    static constexpr uint64_t divide(Type& n, const Divider& divider)
+    {
+        return LimbArithmetic::divide(n.limbs.data(), Type::LIMBS, divider);
+    }
+
+    static constexpr void multiplyAdd(Type& n, uint64_t factor, uint64_t addend)
+    {
+        LimbArithmetic::multiplyAdd(n.limbs.data(), Type::LIMBS, factor, addend);
+    }
+
+    static std::string toString(const Type& n) { return n.toString(); }
+};
+
+} // namespace sqidscxx
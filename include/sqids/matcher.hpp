@@ -0,0 +1,766 @@
+///
+/// @file matcher.hpp
+///
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "error.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SQIDS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SQIDS_MMAP 0
+#endif
+
+namespace sqidscxx
+{
+///
+/// @class BlocklistMatcher
+///
+/// @brief An Aho-Corasick automaton compiled from a cleaned-up blocklist.
+///
+/// The matcher answers the question "does this ID contain a blocked word?"
+/// in a single pass over the ID, using the same rules as the reference
+/// implementation:
+///   - Words with 3 characters (or IDs with 3 characters) only match if the
+///     ID and the word are identical
+///   - Words containing digits (leet speak) only match at the beginning or
+///     the end of the ID
+///   - All other words match anywhere in the ID
+///
+/// Matching is case-insensitive for ASCII characters. Words passed to the
+/// constructor are expected to be lowercase already, with at least 3
+/// characters.
+///
+/// The automaton is stored as a flat binary image, which can be written to a
+/// file with serialize() and used again with load(). Loading maps the file
+/// into memory without parsing it, so processes using the same file share its
+/// pages. Images use the byte order of the machine that wrote them. Loading
+/// checks every index stored in an image once, so that a truncated or damaged
+/// image is rejected instead of being read out of bounds.
+///
+class BlocklistMatcher
+{
+    // Restricts the constructor binding an image to fromImage()
+    struct ImageTag
+    {
+    };
+
+public:
+    BlocklistMatcher();
+
+    template<typename Words>
+    explicit BlocklistMatcher(const Words& words, std::string_view alphabet = {});
+
+    BlocklistMatcher(ImageTag, std::shared_ptr<const void> owner, const void* image);
+
+    static std::shared_ptr<const BlocklistMatcher> load(const std::string& path);
+    static std::shared_ptr<const BlocklistMatcher> fromImage(std::shared_ptr<const void> owner, const void* image,
+                                                             size_t size);
+
+    bool matches(const char* id, size_t length) const;
+    bool matches(std::string_view id) const;
+
+    class Scanner;
+
+    bool empty() const;
+    size_t memoryUsage() const;
+
+    bool supportsAlphabet(std::string_view alphabet) const;
+
+    std::string serialize() const;
+
+private:
+    enum : uint8_t
+    {
+        WORD_EXACT  = 1 << 0,  // A 3-character word ends at this node
+        WORD_LEET   = 1 << 1,  // A word with digits ends at this node
+        OUTPUT_LEET = 1 << 2,  // This node, or one of its suffixes, is a word with digits
+        OUTPUT_ANY  = 1 << 3   // This node, or one of its suffixes, is a word without digits
+    };
+
+    static constexpr uint32_t ROOT = 0;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // The image starts with this header. The arrays follow it: first those
+    // with 4-byte elements, then those with 1-byte elements, so that all of
+    // them are aligned.
+    struct Header
+    {
+        char     magic[8];
+        uint32_t byteOrder;
+        uint32_t version;
+        uint32_t classCount;
+        uint32_t nodeCount;
+        uint32_t edgeCount;
+        uint32_t reserved;
+
+        // Bit `ch` is set if words with the character `ch` were kept, that
+        // is, if the character is in the alphabet the matcher was built for
+        uint8_t  alphabet[32];
+    };
+
+    static constexpr char MAGIC[8] = { 'S', 'Q', 'I', 'D', 'S', 'B', 'L', 'M' };
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr uint32_t VERSION = 1;
+
+    static size_t imageSize(const Header& header);
+
+    uint8_t* bind(const void* image);
+    bool isConsistent() const;
+
+    uint32_t child(uint32_t node, uint8_t cls) const;
+    uint32_t transition(uint32_t node, uint8_t cls) const;
+
+    bool step(uint32_t& node, bool& anchored, char ch) const;
+    bool matchesExact(const char* id, size_t length) const;
+
+    // Keeps the image alive: either owned storage, or a mapped file
+    std::shared_ptr<const void> _owner;
+    const Header* _header = nullptr;
+    size_t _imageSize = 0;
+
+    // Maps each (case-folded) byte to a character class; 0 means the byte
+    // doesn't occur in any blocked word.
+    const uint8_t* _classes = nullptr;
+
+    // Goto function of the root node, indexed by character class.
+    const uint32_t* _rootTransitions = nullptr;
+
+    // Per-node data. Edges of node `n` are `_edges[_edgeOffsets[n]]` up to
+    // (but not including) `_edges[_edgeOffsets[n + 1]]`, sorted by class.
+    const uint32_t* _failureLinks = nullptr;
+    const uint8_t*  _flags = nullptr;
+    const uint32_t* _edgeOffsets = nullptr;
+    const uint8_t*  _edgeClasses = nullptr;
+    const uint32_t* _edgeTargets = nullptr;
+};
+
+///
+/// @class BlocklistMatcher::Scanner
+///
+/// @brief Checks an ID that is only available in pieces, such as an ID being
+///        generated into a small buffer, with the same result as matches().
+///
+/// Typical use:
+///
+/// @code
+/// BlocklistMatcher::Scanner scanner(matcher);
+/// scanner.feed(piece, length);
+/// ...
+/// bool blocked = scanner.finish();
+/// @endcode
+///
+class BlocklistMatcher::Scanner
+{
+public:
+    explicit Scanner(const BlocklistMatcher& matcher);
+
+    void feed(const char* chars, size_t length);
+
+    bool matched() const;
+    bool finish() const;
+
+private:
+    const BlocklistMatcher& _matcher;
+
+    uint32_t _node;
+    bool _anchored;
+    bool _matched;
+
+    // IDs of up to 3 characters are matched as a whole
+    size_t _length;
+    char _start[3];
+};
+
+///
+/// Create an empty matcher which doesn't match any ID.
+///
+inline BlocklistMatcher::BlocklistMatcher()
+  : BlocklistMatcher(std::array<std::string_view, 0>())
+{
+}
+
+///
+/// Use an image that fromImage() has checked, without compiling anything.
+///
+inline BlocklistMatcher::BlocklistMatcher(ImageTag, std::shared_ptr<const void> owner, const void* image)
+  : _owner(std::move(owner))
+{
+    bind(image);
+}
+
+///
+/// Compile a list of blocked words into an automaton.
+///
+/// @param words     A range of lowercase words, each with at least 3
+///                  characters. Shorter words are ignored.
+/// @param alphabet  The lowercase alphabet `words` were filtered for, which
+///                  is recorded for supportsAlphabet(). If empty, any
+///                  alphabet is supported.
+///
+template<typename Words>
+BlocklistMatcher::BlocklistMatcher(const Words& words, std::string_view alphabet)
+{
+    std::array<uint8_t, 256> classes;
+    classes.fill(0);
+
+    // Assign a character class to every character used in the blocklist.
+    // Uppercase letters are counted as lowercase, so there are at most
+    // 256 - 26 classes besides 0, which always fit into a byte.
+    uint32_t classCount = 1;
+    for (const auto& word : words) {
+        for (unsigned char ch : std::string_view(word)) {
+            if (ch >= 'A' && ch <= 'Z') {
+                ch = static_cast<unsigned char>(ch - 'A' + 'a');
+            }
+            if (classes[ch] == 0) {
+                classes[ch] = static_cast<uint8_t>(classCount++);
+            }
+        }
+    }
+
+    // Case-insensitive matching: uppercase letters share the class of their
+    // lowercase counterparts
+    for (unsigned char ch = 'A'; ch <= 'Z'; ch++) {
+        classes[ch] = classes[ch - 'A' + 'a'];
+    }
+
+    // Build the trie
+    struct TrieNode
+    {
+        std::vector<std::pair<uint8_t, uint32_t>> children;
+        uint8_t flags = 0;
+    };
+    std::vector<TrieNode> trie(1);
+
+    for (const auto& word : words) {
+        const std::string_view w(word);
+        if (w.size() < 3) {
+            continue;
+        }
+
+        uint32_t node = ROOT;
+        for (unsigned char ch : w) {
+            const uint8_t cls = classes[ch];
+            auto& children = trie[node].children;
+            auto it = std::find_if(children.begin(), children.end(), [cls](const auto& edge) {
+                return edge.first == cls;
+            });
+            if (it == children.end()) {
+                const uint32_t next = static_cast<uint32_t>(trie.size());
+                children.emplace_back(cls, next);
+                trie.emplace_back();
+                node = next;
+            } else {
+                node = it->second;
+            }
+        }
+
+        if (w.size() == 3) {
+            trie[node].flags |= WORD_EXACT;
+        } else if (std::any_of(w.cbegin(), w.cend(), ::isdigit)) {
+            trie[node].flags |= WORD_LEET | OUTPUT_LEET;
+        } else {
+            trie[node].flags |= OUTPUT_ANY;
+        }
+    }
+
+    // Lay out the image
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = VERSION;
+    header.classCount = classCount;
+    header.nodeCount = static_cast<uint32_t>(trie.size());
+    for (const auto& node : trie) {
+        header.edgeCount += static_cast<uint32_t>(node.children.size());
+    }
+
+    if (alphabet.empty()) {
+        std::fill(std::begin(header.alphabet), std::end(header.alphabet), 0xFF);
+    }
+    for (unsigned char ch : alphabet) {
+        header.alphabet[ch / 8] |= static_cast<uint8_t>(1 << (ch % 8));
+    }
+
+    // Stored as 4-byte words, so that the arrays of the image are aligned
+    auto storage = std::make_shared<std::vector<uint32_t>>((imageSize(header) + 3) / 4, 0);
+    std::memcpy(storage->data(), &header, sizeof(header));
+
+    uint8_t* const image = bind(storage->data());
+    _owner = storage;
+
+    // The arrays are only read through the members; fill them in through
+    // writable pointers to the same storage
+    auto writable = [image](const auto* array) {
+        using Element = std::remove_const_t<std::remove_pointer_t<decltype(array)>>;
+        return reinterpret_cast<Element*>(image + (reinterpret_cast<const uint8_t*>(array) - image));
+    };
+
+    uint32_t* const rootTransitions = writable(_rootTransitions);
+    uint32_t* const failureLinks = writable(_failureLinks);
+    uint8_t* const flags = writable(_flags);
+    uint32_t* const edgeOffsets = writable(_edgeOffsets);
+    uint8_t* const edgeClasses = writable(_edgeClasses);
+    uint32_t* const edgeTargets = writable(_edgeTargets);
+
+    std::copy(classes.cbegin(), classes.cend(), writable(_classes));
+
+    // Flatten the trie into sorted edge arrays
+    const uint32_t nodeCount = header.nodeCount;
+    uint32_t edgeCount = 0;
+
+    for (uint32_t node = 0; node < nodeCount; node++) {
+        auto& children = trie[node].children;
+        std::sort(children.begin(), children.end());
+
+        flags[node] = trie[node].flags;
+        edgeOffsets[node] = edgeCount;
+        for (const auto& edge : children) {
+            edgeClasses[edgeCount] = edge.first;
+            edgeTargets[edgeCount] = edge.second;
+            edgeCount++;
+        }
+    }
+    edgeOffsets[nodeCount] = edgeCount;
+
+    std::fill(rootTransitions, rootTransitions + classCount, ROOT);
+    for (const auto& edge : trie[ROOT].children) {
+        rootTransitions[edge.first] = edge.second;
+    }
+
+    // Compute failure links breadth-first, and fold the outputs of every
+    // node's suffixes into its own flags
+    std::deque<uint32_t> queue;
+    for (const auto& edge : trie[ROOT].children) {
+        queue.push_back(edge.second);
+    }
+
+    while (!queue.empty()) {
+        const uint32_t node = queue.front();
+        queue.pop_front();
+
+        for (uint32_t e = edgeOffsets[node]; e < edgeOffsets[node + 1]; e++) {
+            const uint8_t cls = edgeClasses[e];
+            const uint32_t next = edgeTargets[e];
+
+            failureLinks[next] = transition(failureLinks[node], cls);
+            flags[next] |= flags[failureLinks[next]] & (OUTPUT_LEET | OUTPUT_ANY);
+
+            queue.push_back(next);
+        }
+    }
+}
+
+///
+/// Load a matcher written by serialize(). Where supported, the file is
+/// mapped into memory read-only, and shared with other processes mapping
+/// it; otherwise, it's read into memory.
+///
+/// @throws std::runtime_error When the file can't be read, or isn't a valid
+///                            image
+///
+/// @param path  The file to load
+///
+inline std::shared_ptr<const BlocklistMatcher> BlocklistMatcher::load(const std::string& path)
+{
+#if SQIDS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SQIDS_THROW(std::runtime_error("Cannot open blocklist file " + path + "."));
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+        ::close(fd);
+        SQIDS_THROW(std::runtime_error("Cannot read blocklist file " + path + "."));
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+    void* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED) {
+        SQIDS_THROW(std::runtime_error("Cannot map blocklist file " + path + "."));
+    }
+
+    std::shared_ptr<const void> owner(mapping, [size](const void* data) {
+        ::munmap(const_cast<void*>(data), size);
+    });
+
+    return fromImage(std::move(owner), mapping, size);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        SQIDS_THROW(std::runtime_error("Cannot open blocklist file " + path + "."));
+    }
+
+    const size_t size = static_cast<size_t>(file.tellg());
+    auto storage = std::make_shared<std::vector<uint32_t>>((size + 3) / 4);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(storage->data()), size)) {
+        SQIDS_THROW(std::runtime_error("Cannot read blocklist file " + path + "."));
+    }
+
+    return fromImage(storage, storage->data(), size);
+#endif
+}
+
+///
+/// Use an image written by serialize() in place, without copying it.
+///
+/// @throws std::runtime_error When the image isn't valid
+///
+/// @param owner  Keeps the image alive for as long as the matcher is used
+/// @param image  The image, aligned to 4 bytes
+/// @param size   The size of the image
+///
+inline std::shared_ptr<const BlocklistMatcher> BlocklistMatcher::fromImage(std::shared_ptr<const void> owner,
+                                                                           const void* image, size_t size)
+{
+    Header header;
+    if (size < sizeof(header) || reinterpret_cast<uintptr_t>(image) % alignof(uint32_t) != 0) {
+        SQIDS_THROW(std::runtime_error("Invalid blocklist image."));
+    }
+    std::memcpy(&header, image, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK ||
+        header.version != VERSION || header.classCount == 0 || header.classCount > 256 || header.nodeCount == 0 ||
+        imageSize(header) > size) {
+        SQIDS_THROW(std::runtime_error("Invalid blocklist image."));
+    }
+
+    auto matcher = std::make_shared<const BlocklistMatcher>(ImageTag(), std::move(owner), image);
+    if (!matcher->isConsistent()) {
+        SQIDS_THROW(std::runtime_error("Invalid blocklist image."));
+    }
+
+    return matcher;
+}
+
+///
+/// Check whether an ID contains a blocked word.
+///
+/// @param id      The ID to check
+/// @param length  The length of the ID
+/// @return        `true` if the ID must not be used
+///
+inline bool BlocklistMatcher::matches(const char* id, size_t length) const
+{
+    // Short IDs only match short words, and they have to match completely
+    if (length <= 3) {
+        return matchesExact(id, length);
+    }
+
+    uint32_t node = ROOT;
+
+    // As long as we stay on the trie path from the root, the current node
+    // spells out the entire ID read so far
+    bool anchored = true;
+
+    for (size_t i = 0; i < length; i++) {
+        if (step(node, anchored, id[i])) {
+            return true;
+        }
+    }
+
+    return (_flags[node] & OUTPUT_LEET) != 0;
+}
+
+///
+/// @overload
+///
+inline bool BlocklistMatcher::matches(std::string_view id) const
+{
+    return matches(id.data(), id.size());
+}
+
+///
+/// @return `true` if no word was compiled into this matcher.
+///
+inline bool BlocklistMatcher::empty() const
+{
+    return _edgeOffsets[1] == 0;
+}
+
+///
+/// @return An estimate of the memory used by the matcher, in bytes. For a
+///         loaded matcher, this includes the pages of the file.
+///
+inline size_t BlocklistMatcher::memoryUsage() const
+{
+    return sizeof(*this) + _imageSize;
+}
+
+///
+/// Check that all the words an alphabet can spell were compiled into this
+/// matcher, that is, that the words were filtered with an alphabet which
+/// has all of its characters.
+///
+/// @param alphabet  The alphabet, in any case
+///
+inline bool BlocklistMatcher::supportsAlphabet(std::string_view alphabet) const
+{
+    return std::all_of(alphabet.cbegin(), alphabet.cend(), [this](char ch) {
+        const auto lowercase = static_cast<unsigned char>(::tolower(static_cast<unsigned char>(ch)));
+        return (_header->alphabet[lowercase / 8] & (1 << (lowercase % 8))) != 0;
+    });
+}
+
+///
+/// @return The binary image of the matcher, to be written to a file and
+///         loaded with load()
+///
+inline std::string BlocklistMatcher::serialize() const
+{
+    return std::string(reinterpret_cast<const char*>(_header), _imageSize);
+}
+
+inline size_t BlocklistMatcher::imageSize(const Header& header)
+{
+    const size_t words = size_t(header.classCount) + header.nodeCount + (size_t(header.nodeCount) + 1) +
+                         header.edgeCount;
+    const size_t bytes = 256 + size_t(header.nodeCount) + header.edgeCount;
+
+    return sizeof(Header) + words * sizeof(uint32_t) + bytes;
+}
+
+// Point the arrays into `image`, whose header is valid
+inline uint8_t* BlocklistMatcher::bind(const void* image)
+{
+    uint8_t* const bytes = static_cast<uint8_t*>(const_cast<void*>(image));
+
+    _header = reinterpret_cast<const Header*>(bytes);
+    _imageSize = imageSize(*_header);
+
+    const uint8_t* next = bytes + sizeof(Header);
+    auto take = [&next](size_t count, auto*& array) {
+        array = reinterpret_cast<std::remove_reference_t<decltype(array)>>(next);
+        next += count * sizeof(*array);
+    };
+
+    take(_header->classCount, _rootTransitions);
+    take(_header->nodeCount, _failureLinks);
+    take(_header->nodeCount + 1, _edgeOffsets);
+    take(_header->edgeCount, _edgeTargets);
+    take(256, _classes);
+    take(_header->nodeCount, _flags);
+    take(_header->edgeCount, _edgeClasses);
+
+    return bytes;
+}
+
+// Check that the arrays of an image only refer to classes, nodes and edges
+// that exist, and that failure links can't loop, so that matching never
+// reads outside of the image
+inline bool BlocklistMatcher::isConsistent() const
+{
+    const uint32_t classCount = _header->classCount;
+    const uint32_t nodeCount = _header->nodeCount;
+    const uint32_t edgeCount = _header->edgeCount;
+
+    for (size_t ch = 0; ch < 256; ch++) {
+        if (_classes[ch] >= classCount) {
+            return false;
+        }
+    }
+
+    for (uint32_t cls = 0; cls < classCount; cls++) {
+        if (_rootTransitions[cls] >= nodeCount) {
+            return false;
+        }
+    }
+
+    if (_edgeOffsets[0] != 0 || _edgeOffsets[nodeCount] != edgeCount) {
+        return false;
+    }
+
+    for (uint32_t node = 0; node < nodeCount; node++) {
+        if (_edgeOffsets[node] > _edgeOffsets[node + 1] || _failureLinks[node] >= nodeCount) {
+            return false;
+        }
+    }
+
+    for (uint32_t e = 0; e < edgeCount; e++) {
+        if (_edgeTargets[e] >= nodeCount || _edgeClasses[e] >= classCount) {
+            return false;
+        }
+    }
+
+    // Every node but the root is reached by exactly one edge, and its failure
+    // link leads to a node closer to the root
+    std::vector<uint32_t> depths(nodeCount, NONE);
+    depths[ROOT] = 0;
+
+    std::deque<uint32_t> queue(1, ROOT);
+    while (!queue.empty()) {
+        const uint32_t node = queue.front();
+        queue.pop_front();
+
+        for (uint32_t e = _edgeOffsets[node]; e < _edgeOffsets[node + 1]; e++) {
+            const uint32_t next = _edgeTargets[e];
+            if (depths[next] != NONE) {
+                return false;
+            }
+            depths[next] = depths[node] + 1;
+            queue.push_back(next);
+        }
+    }
+
+    for (uint32_t node = 1; node < nodeCount; node++) {
+        if (depths[node] == NONE || depths[_failureLinks[node]] >= depths[node]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline uint32_t BlocklistMatcher::child(uint32_t node, uint8_t cls) const
+{
+    if (node == ROOT) {
+        const uint32_t next = _rootTransitions[cls];
+        return next == ROOT ? NONE : next;
+    }
+
+    for (uint32_t e = _edgeOffsets[node]; e < _edgeOffsets[node + 1]; e++) {
+        if (_edgeClasses[e] == cls) {
+            return _edgeTargets[e];
+        }
+        if (_edgeClasses[e] > cls) {
+            break;
+        }
+    }
+
+    return NONE;
+}
+
+inline uint32_t BlocklistMatcher::transition(uint32_t node, uint8_t cls) const
+{
+    while (node != ROOT) {
+        const uint32_t next = child(node, cls);
+        if (next != NONE) {
+            return next;
+        }
+        node = _failureLinks[node];
+    }
+
+    return _rootTransitions[cls];
+}
+
+///
+/// Move the automaton on by one character of an ID longer than 3 characters.
+///
+/// @return `true` if a blocked word was found
+///
+inline bool BlocklistMatcher::step(uint32_t& node, bool& anchored, char ch) const
+{
+    const uint8_t cls = _classes[static_cast<unsigned char>(ch)];
+
+    if (anchored) {
+        const uint32_t next = child(node, cls);
+        if (next != NONE) {
+            node = next;
+
+            // Words with leet speak replacements are visible mostly at the
+            // ends of the ID
+            if (_flags[node] & WORD_LEET) {
+                return true;
+            }
+        } else {
+            anchored = false;
+            node = transition(node, cls);
+        }
+    } else {
+        node = transition(node, cls);
+    }
+
+    // Check for blocked word anywhere in the string
+    return (_flags[node] & OUTPUT_ANY) != 0;
+}
+
+inline bool BlocklistMatcher::matchesExact(const char* id, size_t length) const
+{
+    if (length < 3) {
+        return false;
+    }
+
+    uint32_t node = ROOT;
+    for (size_t i = 0; i < length; i++) {
+        node = child(node, _classes[static_cast<unsigned char>(id[i])]);
+        if (node == NONE) {
+            return false;
+        }
+    }
+
+    return (_flags[node] & WORD_EXACT) != 0;
+}
+
+///
+/// @param matcher  The matcher to check the ID against. It must outlive the
+///                 scanner.
+///
+inline BlocklistMatcher::Scanner::Scanner(const BlocklistMatcher& matcher)
+  : _matcher(matcher),
+    _node(ROOT),
+    _anchored(true),
+    _matched(false),
+    _length(0)
+{
+}
+
+///
+/// Read the next piece of the ID.
+///
+inline void BlocklistMatcher::Scanner::feed(const char* chars, size_t length)
+{
+    for (size_t i = 0; i < length && _length + i < sizeof(_start); i++) {
+        _start[_length + i] = chars[i];
+    }
+    _length += length;
+
+    for (size_t i = 0; i < length && !_matched; i++) {
+        _matched = _matcher.step(_node, _anchored, chars[i]);
+    }
+}
+
+///
+/// @return `true` if the ID read so far is long enough to be checked
+///         piecewise and already contains a blocked word, whatever follows
+///
+inline bool BlocklistMatcher::Scanner::matched() const
+{
+    return _matched && _length > sizeof(_start);
+}
+
+///
+/// @return `true` if the whole ID contains a blocked word, as matches()
+///         would tell
+///
+inline bool BlocklistMatcher::Scanner::finish() const
+{
+    if (_length <= sizeof(_start)) {
+        return _matcher.matchesExact(_start, _length);
+    }
+
+    return _matched || (_matcher._flags[_node] & OUTPUT_LEET) != 0;
+}
+
+} // namespace sqidscxx
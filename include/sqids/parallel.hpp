@@ -0,0 +1,442 @@
+///
+/// @file parallel.hpp
+///
+/// Multi-threaded bulk encoding and decoding, built on top of the batch API.
+///
+/// `Sqids` instances are immutable once constructed, so a single instance can
+/// be shared by any number of threads. The functions in this file split the
+/// input into contiguous ranges, one per task, and run the tasks twice: first
+/// to measure the output of every ID, then, once the output has been sized,
+/// to write each range in place. Nothing is copied after the tasks have
+/// finished.
+///
+/// Every function comes in two forms. One takes a number of tasks and an
+/// Executor, which runs the tasks of each pass. The other takes a number of
+/// threads, 0 meaning the number of hardware threads, and runs one task per
+/// thread. Its threads are started once and run both passes, waiting for
+/// each other in between.
+///
+/// Programs using this header need to link against the platform's thread
+/// library (`Threads::Threads` in CMake).
+///
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "sqids.hpp"
+
+namespace sqidscxx
+{
+///
+/// Runs `taskCount` tasks, calling `task` with each index from 0 up to
+/// `taskCount - 1`, and returns once all of them have completed. Tasks may
+/// run concurrently. If a task throws, the executor is expected to rethrow
+/// the exception after all tasks have finished.
+///
+using Executor = std::function<void(size_t taskCount, const std::function<void(size_t)>& task)>;
+
+namespace detail
+{
+///
+/// @return `threads`, or the number of hardware threads if it's 0
+///
+inline unsigned int threadCount(unsigned int threads)
+{
+    return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+///
+/// Calls `task` with every index from 0 up to `taskCount - 1`, each index
+/// taken by the first caller to get to it, and stores what they throw in
+/// `errors`.
+///
+inline void runTasks(std::atomic<size_t>& next, size_t taskCount, const std::function<void(size_t)>& task,
+                     std::vector<std::exception_ptr>& errors)
+{
+    for (size_t i = next++; i < taskCount; i = next++) {
+#if SQIDS_EXCEPTIONS
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+#else
+        (void)errors;
+        task(i);
+#endif
+    }
+}
+
+inline void rethrowFirst(const std::vector<std::exception_ptr>& errors)
+{
+#if SQIDS_EXCEPTIONS
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#else
+    (void)errors;
+#endif
+}
+
+} // namespace detail
+
+///
+/// Create an executor which runs the tasks on a bounded set of `std::thread`
+/// workers. Each worker takes the next task not yet started until none are
+/// left, so there are never more threads than `maxThreads`, however many
+/// tasks there are.
+///
+/// The workers are started anew for every call. encodeParallel() and
+/// decodeParallel() call an executor twice, so they start two sets of
+/// threads with it; their overloads taking a number of threads start one.
+///
+/// @param maxThreads  The most threads to run at once. If 0, the number of
+///                    hardware threads is used.
+///
+/// @return An executor which can be passed to encodeParallel() and
+///         decodeParallel()
+///
+inline Executor threadExecutor(unsigned int maxThreads = 0)
+{
+    maxThreads = detail::threadCount(maxThreads);
+
+    return [maxThreads](size_t taskCount, const std::function<void(size_t)>& task) {
+        std::vector<std::exception_ptr> errors(taskCount);
+        std::atomic<size_t> next(0);
+
+        // The calling thread is one of the workers
+        const size_t workerCount = std::min<size_t>(taskCount, maxThreads);
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount > 0 ? workerCount - 1 : 0);
+
+        for (size_t i = 1; i < workerCount; i++) {
+            threads.emplace_back([&]() {
+                detail::runTasks(next, taskCount, task, errors);
+            });
+        }
+        detail::runTasks(next, taskCount, task, errors);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        detail::rethrowFirst(errors);
+    };
+}
+
+namespace detail
+{
+///
+/// The first ID of `task`, which is also the end of the task before it
+///
+inline size_t taskBegin(size_t task, size_t idsPerTask, size_t count)
+{
+    return std::min(task * idsPerTask, count);
+}
+
+///
+/// Turns the sizes written to `offsets[i + 1]` by every task, relative to
+/// the start of its range, into offsets within the whole output. `starts`
+/// holds the total of each task at `task + 1` and becomes the start of each.
+///
+/// @return The size of the whole output
+///
+inline size_t placeTasks(std::vector<size_t>& starts)
+{
+    for (size_t task = 1; task < starts.size(); task++) {
+        starts[task] += starts[task - 1];
+    }
+
+    return starts.back();
+}
+
+///
+/// Runs the tasks of both passes with `executor`, and `between` once the
+/// first pass is done.
+///
+inline void runPasses(const Executor& executor, size_t taskCount, const std::function<void(size_t)>& first,
+                      const std::function<void()>& between, const std::function<void(size_t)>& second)
+{
+    executor(taskCount, first);
+    between();
+    executor(taskCount, second);
+}
+
+///
+/// Runs the tasks of both passes on up to `threads` threads, one task per
+/// thread. The calling thread is one of them, and runs `between` once all
+/// of them are done with the first pass; the others wait for it. If a task
+/// or `between` throws, the second pass is skipped.
+///
+inline void runPasses(unsigned int threads, size_t taskCount, const std::function<void(size_t)>& first,
+                      const std::function<void()>& between, const std::function<void(size_t)>& second)
+{
+    std::vector<std::exception_ptr> errors(taskCount + 1);
+    std::atomic<size_t> nextFirst(0);
+    std::atomic<size_t> nextSecond(0);
+
+    const size_t workerCount = std::min<size_t>(taskCount, threads);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t firstDone = 0;
+    bool placed = false;
+    bool failed = false;
+
+    const auto work = [&]() {
+        runTasks(nextFirst, taskCount, first, errors);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (++firstDone == workerCount) {
+                changed.notify_all();
+            }
+            changed.wait(lock, [&placed]() {
+                return placed;
+            });
+            if (failed) {
+                return;
+            }
+        }
+
+        runTasks(nextSecond, taskCount, second, errors);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount > 0 ? workerCount - 1 : 0);
+    for (size_t i = 1; i < workerCount; i++) {
+        workers.emplace_back(work);
+    }
+
+    runTasks(nextFirst, taskCount, first, errors);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++firstDone;
+        changed.wait(lock, [&firstDone, workerCount]() {
+            return firstDone >= workerCount;
+        });
+
+        failed = std::any_of(errors.cbegin(), errors.cend(), [](const auto& error) {
+            return error != nullptr;
+        });
+        if (!failed) {
+#if SQIDS_EXCEPTIONS
+            try {
+                between();
+            } catch (...) {
+                errors[taskCount] = std::current_exception();
+                failed = true;
+            }
+#else
+            between();
+#endif
+        }
+
+        placed = true;
+        changed.notify_all();
+    }
+
+    if (!failed) {
+        runTasks(nextSecond, taskCount, second, errors);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    rethrowFirst(errors);
+}
+
+template<typename T, typename Runner>
+void encodeParallel(const Sqids<T>& sqids, const T* numbers, size_t count, size_t arity, EncodedBatch& out,
+                    size_t taskCount, const Runner& runner)
+{
+    taskCount = std::max<size_t>(1, std::min(taskCount, count));
+
+    const size_t idsPerTask = (count + taskCount - 1) / taskCount;
+
+    out.offsets.resize(count + 1);
+    out.offsets[0] = 0;
+
+    std::vector<size_t> starts(taskCount + 1, 0);
+
+    runPasses(
+        runner, taskCount,
+        // Measure every ID, relative to the start of its task
+        [&](size_t task) {
+            const size_t begin = taskBegin(task, idsPerTask, count);
+            const size_t end = taskBegin(task + 1, idsPerTask, count);
+
+            size_t total = 0;
+            for (size_t i = begin; i < end; i++) {
+                total += sqids.encodedLength(numbers + i * arity, arity);
+                out.offsets[i + 1] = total;
+            }
+            starts[task + 1] = total;
+        },
+        [&]() {
+            out.buffer.resize(placeTasks(starts));
+        },
+        // Encode every ID straight into its place in the output
+        [&](size_t task) {
+            const size_t begin = taskBegin(task, idsPerTask, count);
+            const size_t end = taskBegin(task + 1, idsPerTask, count);
+
+            size_t position = starts[task];
+            for (size_t i = begin; i < end; i++) {
+                const size_t idEnd = starts[task] + out.offsets[i + 1];
+                sqids.encodeTo(numbers + i * arity, arity, &out.buffer[position], idEnd - position);
+                out.offsets[i + 1] = position = idEnd;
+            }
+        });
+}
+
+template<typename T, typename Ids, typename Runner>
+void decodeParallel(const Sqids<T>& sqids, const Ids& ids, size_t count, DecodedBatch<T>& out, size_t taskCount,
+                    const Runner& runner)
+{
+    taskCount = std::max<size_t>(1, std::min(taskCount, count));
+
+    const size_t idsPerTask = (count + taskCount - 1) / taskCount;
+
+    out.offsets.resize(count + 1);
+    out.offsets[0] = 0;
+
+    std::vector<size_t> starts(taskCount + 1, 0);
+
+    runPasses(
+        runner, taskCount,
+        // Count the integers of every ID, relative to the start of its task
+        [&](size_t task) {
+            const size_t begin = taskBegin(task, idsPerTask, count);
+            const size_t end = taskBegin(task + 1, idsPerTask, count);
+
+            size_t total = 0;
+            for (size_t i = begin; i < end; i++) {
+                total += sqids.decodedCount(ids[i]);
+                out.offsets[i + 1] = total;
+            }
+            starts[task + 1] = total;
+        },
+        [&]() {
+            out.numbers.resize(placeTasks(starts));
+        },
+        // Decode every ID straight into its place in the output
+        [&](size_t task) {
+            const size_t begin = taskBegin(task, idsPerTask, count);
+            const size_t end = taskBegin(task + 1, idsPerTask, count);
+
+            size_t position = starts[task];
+            for (size_t i = begin; i < end; i++) {
+                const size_t idEnd = starts[task] + out.offsets[i + 1];
+                sqids.decodeInto(ids[i], out.numbers.data() + position, idEnd - position);
+                out.offsets[i + 1] = position = idEnd;
+            }
+        });
+}
+
+} // namespace detail
+
+///
+/// Encode many IDs with the same number of integers each, spreading the work
+/// over `taskCount` tasks run by `executor`. The result is identical to
+/// Sqids::encodeBatch().
+///
+/// The tasks first measure their IDs with Sqids::encodedLength(), so that
+/// `out` is sized once, then run again to encode every ID in its place.
+///
+/// @throws std::runtime_error When encoding fails
+///
+/// @param sqids      The instance to encode with
+/// @param numbers    The integers to encode, `arity` for each ID
+/// @param count      The number of IDs to generate
+/// @param arity      The number of integers in each ID
+/// @param out        Receives the generated IDs
+/// @param taskCount  The number of tasks to split the work into
+/// @param executor   Runs the tasks, twice
+///
+template<typename T>
+void encodeParallel(const Sqids<T>& sqids, const T* numbers, size_t count, size_t arity, EncodedBatch& out,
+                    size_t taskCount, const Executor& executor)
+{
+    detail::encodeParallel(sqids, numbers, count, arity, out, taskCount, executor);
+}
+
+///
+/// @overload
+///
+template<typename T>
+void encodeParallel(const Sqids<T>& sqids, const T* numbers, size_t count, size_t arity, EncodedBatch& out,
+                    unsigned int threads = 0)
+{
+    threads = detail::threadCount(threads);
+
+    detail::encodeParallel(sqids, numbers, count, arity, out, threads, threads);
+}
+
+///
+/// Decode many IDs, spreading the work over `taskCount` tasks run by
+/// `executor`. The result is identical to Sqids::decodeBatch().
+///
+/// The tasks first count the integers of their IDs with
+/// Sqids::decodedCount(), so that `out` is sized once, then run again to
+/// decode every ID in its place.
+///
+/// @param sqids      The instance to decode with
+/// @param ids        The IDs to decode
+/// @param count      The number of IDs
+/// @param out        Receives the decoded integers
+/// @param taskCount  The number of tasks to split the work into
+/// @param executor   Runs the tasks, twice
+///
+template<typename T>
+void decodeParallel(const Sqids<T>& sqids, const std::string_view* ids, size_t count, DecodedBatch<T>& out,
+                    size_t taskCount, const Executor& executor)
+{
+    detail::decodeParallel(sqids, ids, count, out, taskCount, executor);
+}
+
+///
+/// @overload
+///
+template<typename T>
+void decodeParallel(const Sqids<T>& sqids, const EncodedBatch& ids, DecodedBatch<T>& out, size_t taskCount,
+                    const Executor& executor)
+{
+    detail::decodeParallel(sqids, ids, ids.size(), out, taskCount, executor);
+}
+
+///
+/// @overload
+///
+template<typename T>
+void decodeParallel(const Sqids<T>& sqids, const std::string_view* ids, size_t count, DecodedBatch<T>& out,
+                    unsigned int threads = 0)
+{
+    threads = detail::threadCount(threads);
+
+    detail::decodeParallel(sqids, ids, count, out, threads, threads);
+}
+
+///
+/// @overload
+///
+template<typename T>
+void decodeParallel(const Sqids<T>& sqids, const EncodedBatch& ids, DecodedBatch<T>& out, unsigned int threads = 0)
+{
+    threads = detail::threadCount(threads);
+
+    detail::decodeParallel(sqids, ids, ids.size(), out, threads, threads);
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,245 @@
+///
+/// @file registry.hpp
+///
+/// A cache of `Sqids` instances for programs that use many different options,
+/// such as one alphabet per tenant.
+///
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include "sqids.hpp"
+
+namespace sqidscxx
+{
+///
+/// @class SqidsRegistry
+///
+/// @brief A thread-safe cache which maps options to shared, immutable `Sqids`
+///        instances, evicting the least recently used ones once the
+///        instances take up more than a given amount of memory.
+///
+/// Instances are handed out as `std::shared_ptr`, so an evicted instance
+/// stays valid for as long as it's in use. Instances built from the same
+/// blocklist share its compiled matcher with all other instances whose
+/// alphabets use the same characters (see Blocklist). A shared matcher is
+/// counted once towards the capacity, however many cached instances use it,
+/// until the last of them is evicted.
+///
+/// Typical use:
+///
+/// @code
+/// sqidscxx::SqidsRegistry<> registry(16 * 1024 * 1024);
+///
+/// auto sqids = registry.get({ alphabet: tenant.alphabet, minLength: 8 });
+/// auto id = sqids->encode({ 1, 2, 3 });
+/// @endcode
+///
+template<typename T = uint64_t>
+class SqidsRegistry
+{
+public:
+    struct Statistics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+
+        // The number of cached instances, and their estimated memory usage
+        size_t size = 0;
+        size_t bytes = 0;
+    };
+
+    explicit SqidsRegistry(size_t capacity);
+
+    std::shared_ptr<const Sqids<T>> get(const SqidsOptions& options);
+
+    Statistics statistics() const;
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<const Sqids<T>> sqids;
+
+        // Not counting the blocklist matcher
+        size_t bytes;
+    };
+
+    static std::string makeKey(const SqidsOptions& options);
+
+    void evict();
+
+    const size_t _capacity;
+
+    mutable std::mutex _mutex;
+
+    // Most recently used first
+    std::list<Entry> _entries;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> _index;
+
+    // The number of cached instances using each blocklist matcher
+    std::unordered_map<const BlocklistMatcher*, size_t> _matcherUses;
+
+    Statistics _statistics;
+};
+
+///
+/// @param capacity  The memory the cached instances may use, in bytes, as
+///                  estimated by Sqids::memoryUsage(), with every blocklist
+///                  matcher counted once. The most recently used instance is
+///                  always kept, even if it's larger.
+///
+template<typename T>
+SqidsRegistry<T>::SqidsRegistry(size_t capacity)
+  : _capacity(capacity)
+{
+}
+
+///
+/// Look up the instance for `options`, creating it if it isn't cached.
+///
+/// @throws std::runtime_error When `options` are invalid
+///
+/// @param options  The options of the instance
+/// @return         An instance equivalent to `Sqids<T>(options)`
+///
+template<typename T>
+std::shared_ptr<const Sqids<T>> SqidsRegistry<T>::get(const SqidsOptions& options)
+{
+    std::string key = makeKey(options);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            _entries.splice(_entries.begin(), _entries, it->second);
+            _statistics.hits++;
+            return it->second->sqids;
+        }
+
+        _statistics.misses++;
+    }
+
+    // Shuffling the alphabets and compiling a blocklist take far longer than
+    // any lookup, so they run unlocked: hits on other options are served
+    // meanwhile, and a race for the same options is settled below.
+    auto sqids = std::make_shared<const Sqids<T>>(options);
+    const auto& matcher = sqids->blocklistMatcher();
+    const size_t bytes = sqids->memoryUsage() - matcher->memoryUsage();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Another thread may have created the same instance in the meantime
+    auto it = _index.find(key);
+    if (it != _index.end()) {
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return it->second->sqids;
+    }
+
+    _entries.push_front(Entry { std::move(key), sqids, bytes });
+    _index.emplace(_entries.front().key, _entries.begin());
+    _statistics.size++;
+    _statistics.bytes += bytes;
+
+    // The matcher is counted with the first cached instance using it
+    if (_matcherUses[matcher.get()]++ == 0) {
+        _statistics.bytes += matcher->memoryUsage();
+    }
+
+    evict();
+
+    return sqids;
+}
+
+///
+/// @return The counters of the registry
+///
+template<typename T>
+typename SqidsRegistry<T>::Statistics SqidsRegistry<T>::statistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _statistics;
+}
+
+///
+/// Remove all instances from the registry. The counters are kept.
+///
+template<typename T>
+void SqidsRegistry<T>::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _index.clear();
+    _entries.clear();
+    _matcherUses.clear();
+    _statistics.size = 0;
+    _statistics.bytes = 0;
+}
+
+template<typename T>
+std::string SqidsRegistry<T>::makeKey(const SqidsOptions& options)
+{
+    std::string key;
+
+    // Every field is prefixed with its length, so that different options
+    // never produce the same key
+    const auto append = [&key](std::string_view field) {
+        const uint32_t length = static_cast<uint32_t>(field.size());
+        key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        key.append(field);
+    };
+
+    append(options.alphabet);
+    key += static_cast<char>(options.minLength);
+    key += static_cast<char>(options.alphabetCacheDepth);
+    key += options.canonicalDecoding ? 'c' : 'n';
+    if (options.blocklist.isDefault()) {
+        key += 'd';
+    } else if (options.blocklist.matcher()) {
+        // Precompiled blocklists are told apart by their matcher
+        const void* matcher = options.blocklist.matcher().get();
+        key += 'p';
+        key.append(reinterpret_cast<const char*>(&matcher), sizeof(matcher));
+    } else {
+        key += 'c';
+        for (const auto& word : options.blocklist) {
+            append(word);
+        }
+    }
+
+    return key;
+}
+
+template<typename T>
+void SqidsRegistry<T>::evict()
+{
+    while (_statistics.bytes > _capacity && _entries.size() > 1) {
+        const Entry& entry = _entries.back();
+
+        _statistics.bytes -= entry.bytes;
+        _statistics.size--;
+        _statistics.evictions++;
+
+        // The matcher is uncounted with the last cached instance using it
+        const auto& matcher = entry.sqids->blocklistMatcher();
+        auto uses = _matcherUses.find(matcher.get());
+        if (--uses->second == 0) {
+            _statistics.bytes -= matcher->memoryUsage();
+            _matcherUses.erase(uses);
+        }
+
+        _index.erase(entry.key);
+        _entries.pop_back();
+    }
+}
+
+} // namespace sqidscxx
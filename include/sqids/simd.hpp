@@ -0,0 +1,324 @@
+///
+/// @file simd.hpp
+///
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(SQIDS_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SQIDS_SIMD_X86 1
+#include <immintrin.h>
+#define SQIDS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SQIDS_SIMD_X86 0
+#endif
+
+namespace sqidscxx
+{
+///
+/// @class AlphabetLookup
+///
+/// @brief Validates IDs against an alphabet and maps their characters to
+///        positions in the alphabet, many characters at a time.
+///
+/// On x86 processors, AVX2 or SSE4.2 instructions are used when the CPU
+/// supports them, selected at runtime. Everywhere else, and when
+/// `SQIDS_NO_SIMD` is defined, a scalar table lookup is used instead.
+///
+/// Alphabets never contain multibyte characters, so only the 128 ASCII
+/// characters need to be looked up. Each character is split into its high
+/// and low nibble: the low nibble selects a byte from a 16-byte table with a
+/// byte shuffle, and the high nibble selects which of the 8 tables to use.
+///
+/// The tables can be built at compile time. The instruction set is detected
+/// once per process, the first time an ID is looked up.
+///
+class AlphabetLookup
+{
+public:
+    static constexpr uint8_t NOT_IN_ALPHABET = 0xFF;
+
+    constexpr AlphabetLookup() = default;
+    constexpr explicit AlphabetLookup(const std::array<uint8_t, 256>& index);
+
+    bool validate(const char* input, size_t length) const;
+    bool map(const char* input, size_t length, uint8_t* out) const;
+
+private:
+    enum class InstructionSet
+    {
+        Scalar,
+        Sse42,
+        Avx2
+    };
+
+    static InstructionSet detectInstructionSet();
+
+    bool validateScalar(const char* input, size_t length) const;
+    bool mapScalar(const char* input, size_t length, uint8_t* out) const;
+
+#if SQIDS_SIMD_X86
+    SQIDS_TARGET("sse4.2") bool validateSse42(const char* input, size_t length) const;
+    SQIDS_TARGET("sse4.2") bool mapSse42(const char* input, size_t length, uint8_t* out) const;
+    SQIDS_TARGET("avx2") bool validateAvx2(const char* input, size_t length) const;
+    SQIDS_TARGET("avx2") bool mapAvx2(const char* input, size_t length, uint8_t* out) const;
+#endif
+
+    // The position of every byte in the alphabet
+    std::array<uint8_t, 256> _index {};
+
+    // `_positions[hi][lo]` is the position of character `hi * 16 + lo`
+    alignas(16) uint8_t _positions[8][16] {};
+
+    // Bit `hi` of `_bitmap[lo]` is set if character `hi * 16 + lo` is in the
+    // alphabet
+    alignas(16) uint8_t _bitmap[16] {};
+
+    // A character of the alphabet, used to pad incomplete blocks
+    char _padding = 0;
+};
+
+///
+/// @param index  The position of every byte in the alphabet, or
+///               `NOT_IN_ALPHABET`
+///
+constexpr AlphabetLookup::AlphabetLookup(const std::array<uint8_t, 256>& index)
+  : _index(index)
+{
+    for (unsigned int hi = 0; hi < 8; hi++) {
+        for (unsigned int lo = 0; lo < 16; lo++) {
+            const unsigned int ch = hi * 16 + lo;
+            _positions[hi][lo] = index[ch];
+
+            if (index[ch] != NOT_IN_ALPHABET) {
+                _bitmap[lo] |= static_cast<uint8_t>(1 << hi);
+                _padding = static_cast<char>(ch);
+            }
+        }
+    }
+}
+
+///
+/// Check that every character of `input` is in the alphabet.
+///
+/// @return `false` as soon as a character that isn't in the alphabet is found
+///
+inline bool AlphabetLookup::validate(const char* input, size_t length) const
+{
+    switch (detectInstructionSet()) {
+#if SQIDS_SIMD_X86
+        case InstructionSet::Avx2:
+            return validateAvx2(input, length);
+        case InstructionSet::Sse42:
+            return validateSse42(input, length);
+#endif
+        default:
+            return validateScalar(input, length);
+    }
+}
+
+///
+/// Look up the position of every character of `input` in the alphabet.
+///
+/// @param out  Receives `length` positions
+/// @return     `false` if a character isn't in the alphabet, in which case the
+///             contents of `out` are unspecified
+///
+inline bool AlphabetLookup::map(const char* input, size_t length, uint8_t* out) const
+{
+    switch (detectInstructionSet()) {
+#if SQIDS_SIMD_X86
+        case InstructionSet::Avx2:
+            return mapAvx2(input, length, out);
+        case InstructionSet::Sse42:
+            return mapSse42(input, length, out);
+#endif
+        default:
+            return mapScalar(input, length, out);
+    }
+}
+
+inline AlphabetLookup::InstructionSet AlphabetLookup::detectInstructionSet()
+{
+#if SQIDS_SIMD_X86
+    static const InstructionSet instructionSet = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return InstructionSet::Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return InstructionSet::Sse42;
+        }
+        return InstructionSet::Scalar;
+    }();
+
+    return instructionSet;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+inline bool AlphabetLookup::validateScalar(const char* input, size_t length) const
+{
+    for (size_t i = 0; i < length; i++) {
+        if (_index[static_cast<unsigned char>(input[i])] == NOT_IN_ALPHABET) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool AlphabetLookup::mapScalar(const char* input, size_t length, uint8_t* out) const
+{
+    for (size_t i = 0; i < length; i++) {
+        out[i] = _index[static_cast<unsigned char>(input[i])];
+        if (out[i] == NOT_IN_ALPHABET) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#if SQIDS_SIMD_X86
+
+SQIDS_TARGET("sse4.2")
+inline bool AlphabetLookup::validateSse42(const char* input, size_t length) const
+{
+    const __m128i bitmap = _mm_load_si128(reinterpret_cast<const __m128i*>(_bitmap));
+    const __m128i rows = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbles = _mm_set1_epi8(0x0F);
+
+    alignas(16) char tail[16];
+
+    for (size_t i = 0; i < length; i += 16) {
+        const char* block = input + i;
+
+        // Pad the last, incomplete block with a valid character
+        if (length - i < 16) {
+            std::memset(tail, _padding, sizeof(tail));
+            std::memcpy(tail, block, length - i);
+            block = tail;
+        }
+
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        const __m128i lo = _mm_and_si128(chars, nibbles);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(chars, 4), nibbles);
+
+        // Bytes with the high bit set select a zero row, so they never match
+        const __m128i found = _mm_and_si128(_mm_shuffle_epi8(bitmap, lo), _mm_shuffle_epi8(rows, hi));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128())) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+SQIDS_TARGET("sse4.2")
+inline bool AlphabetLookup::mapSse42(const char* input, size_t length, uint8_t* out) const
+{
+    const __m128i nibbles = _mm_set1_epi8(0x0F);
+    const __m128i notInAlphabet = _mm_set1_epi8(static_cast<char>(NOT_IN_ALPHABET));
+
+    alignas(16) char tail[16];
+
+    for (size_t i = 0; i < length; i += 16) {
+        const char* block = input + i;
+        const size_t blockLength = std::min<size_t>(length - i, 16);
+
+        // Pad the last, incomplete block with a valid character
+        if (blockLength < 16) {
+            std::memset(tail, _padding, sizeof(tail));
+            std::memcpy(tail, block, blockLength);
+            block = tail;
+        }
+
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        const __m128i lo = _mm_and_si128(chars, nibbles);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(chars, 4), nibbles);
+
+        // Bytes with the high bit set match no table, and stay not found
+        __m128i positions = notInAlphabet;
+        for (int row = 0; row < 8; row++) {
+            const __m128i table = _mm_load_si128(reinterpret_cast<const __m128i*>(_positions[row]));
+            const __m128i selected = _mm_cmpeq_epi8(hi, _mm_set1_epi8(static_cast<char>(row)));
+            positions = _mm_blendv_epi8(positions, _mm_shuffle_epi8(table, lo), selected);
+        }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(positions, notInAlphabet)) != 0) {
+            return false;
+        }
+
+        if (blockLength == 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), positions);
+        } else {
+            alignas(16) uint8_t mapped[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(mapped), positions);
+            std::memcpy(out + i, mapped, blockLength);
+        }
+    }
+
+    return true;
+}
+
+SQIDS_TARGET("avx2")
+inline bool AlphabetLookup::validateAvx2(const char* input, size_t length) const
+{
+    const __m256i bitmap = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(_bitmap)));
+    const __m256i rows = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibbles = _mm256_set1_epi8(0x0F);
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i lo = _mm256_and_si256(block, nibbles);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbles);
+        const __m256i found = _mm256_and_si256(_mm256_shuffle_epi8(bitmap, lo), _mm256_shuffle_epi8(rows, hi));
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(found, _mm256_setzero_si256())) != 0) {
+            return false;
+        }
+    }
+
+    return validateSse42(input + i, length - i);
+}
+
+SQIDS_TARGET("avx2")
+inline bool AlphabetLookup::mapAvx2(const char* input, size_t length, uint8_t* out) const
+{
+    const __m256i nibbles = _mm256_set1_epi8(0x0F);
+    const __m256i notInAlphabet = _mm256_set1_epi8(static_cast<char>(NOT_IN_ALPHABET));
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i lo = _mm256_and_si256(block, nibbles);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbles);
+
+        __m256i positions = notInAlphabet;
+        for (int row = 0; row < 8; row++) {
+            const __m256i table =
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(_positions[row])));
+            const __m256i selected = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(static_cast<char>(row)));
+            positions = _mm256_blendv_epi8(positions, _mm256_shuffle_epi8(table, lo), selected);
+        }
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(positions, notInAlphabet)) != 0) {
+            return false;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), positions);
+    }
+
+    return mapSse42(input + i, length - i, out + i);
+}
+
+#endif
+
+} // namespace sqidscxx
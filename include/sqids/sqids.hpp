@@ -36,15 +36,44 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include "blocklist.hpp"
+#include "divider.hpp"
+#include "error.hpp"
+#include "instrumentation.hpp"
+#include "integer.hpp"
+#include "matcher.hpp"
+#include "simd.hpp"
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define SQIDS_PMR 1
+#else
+#define SQIDS_PMR 0
+#endif
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#define SQIDS_SPAN 1
+#else
+#define SQIDS_SPAN 0
+#endif
 
 namespace sqidscxx
 {
@@ -71,7 +100,122 @@ struct SqidsOptions
     ///
     /// A list of words that must never appear in IDs.
     ///
-    std::set<std::string> blocklist = std::set<std::string>(DEFAULT_BLOCKLIST);
+    Blocklist blocklist = Blocklist::defaults();
+
+    ///
+    /// The number of alphabet generations to precompute for every possible
+    /// `prefix`: the re-arranged alphabet that encoding and decoding start
+    /// from, followed by the alphabets produced by shuffling it between
+    /// numbers. Set to 0 to build alphabets on the fly instead.
+    ///
+    /// The table takes 2 × depth × size² bytes, where `size` is the length of
+    /// the alphabet. See Sqids::alphabetCacheBytes().
+    ///
+    uint8_t alphabetCacheDepth = 0;
+
+    ///
+    /// Only decode IDs exactly as encode() generates them for their numbers.
+    /// Without it, IDs with different padding, leading zero digits, or which
+    /// encode() would have re-generated because of the blocklist decode to
+    /// the same numbers as the canonical ID. Other IDs decode to an empty
+    /// sequence, or Error::NonCanonical.
+    ///
+    /// Verification reuses the alphabets computed while decoding, so it
+    /// doesn't take a second encode() in almost all cases.
+    ///
+    bool canonicalDecoding = false;
+};
+
+///
+/// @struct EncodedBatch
+///
+/// @brief IDs generated by Sqids::encodeBatch(), packed back to back into a
+///        single buffer.
+///
+struct EncodedBatch
+{
+    ///
+    /// The characters of all IDs.
+    ///
+    std::string buffer;
+
+    ///
+    /// ID `i` spans `buffer` from `offsets[i]` up to `offsets[i + 1]`. There
+    /// is one more offset than there are IDs.
+    ///
+    std::vector<size_t> offsets;
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    std::string_view operator[](size_t i) const
+    {
+        return std::string_view(buffer).substr(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+///
+/// @struct DecodedBatch
+///
+/// @brief Numbers decoded by Sqids::decodeBatch(), packed back to back into a
+///        single array.
+///
+template<typename T>
+struct DecodedBatch
+{
+    ///
+    /// The numbers of all IDs.
+    ///
+    std::vector<T> numbers;
+
+    ///
+    /// The numbers of ID `i` span `numbers` from `offsets[i]` up to
+    /// `offsets[i + 1]`. There is one more offset than there are IDs.
+    ///
+    std::vector<size_t> offsets;
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    const T* data(size_t i) const { return numbers.data() + offsets[i]; }
+    size_t count(size_t i) const { return offsets[i + 1] - offsets[i]; }
+};
+
+///
+/// @struct AlphabetTables
+///
+/// @brief Everything Sqids derives from an alphabet, computed ahead of time.
+///        FixedAlphabet computes them at compile time.
+///
+struct AlphabetTables
+{
+    ///
+    /// The alphabet after the initial shuffle.
+    ///
+    std::string_view chars;
+
+    ///
+    /// The position of every byte in `chars`, and the same positions as
+    /// looked up while validating IDs.
+    ///
+    const std::array<uint8_t, 256>* index;
+    const AlphabetLookup* lookup;
+
+    ///
+    /// The alphabet re-arranged for every offset, one after the other, and
+    /// the position of every character in each of them, indexed by its
+    /// position in `chars`. Both have `chars.size()²` elements.
+    ///
+    const char* rotations;
+    const uint8_t* positions;
+
+    ///
+    /// Divide by the length of the alphabet, by the number of digits, and by
+    /// the largest power of the number of digits below 2^32, which has
+    /// `chunkDigits` digits.
+    ///
+    Divider alphabetDivider;
+    Divider digitDivider;
+    Divider chunkDivider;
+    size_t chunkDigits;
 };
 
 ///
@@ -96,6 +240,13 @@ struct SqidsOptions
 /// // numbers = { 1, 2, 3 }
 /// @endcode
 ///
+/// `T` can be any built-in integer type of up to 64 bits, `unsigned __int128`
+/// or BigUint; see IntegerTraits to add other types.
+///
+/// An instance never changes after it has been constructed, so all of its
+/// member functions can be called concurrently from any number of threads.
+/// See parallel.hpp for multi-threaded bulk encoding and decoding.
+///
 template<typename T = uint64_t>
 class Sqids
 {
@@ -111,30 +262,289 @@ public:
     std::string encode(const std::vector<T>& numbers) const;
     std::vector<T> decode(std::string_view id) const;
 
-    static constexpr T maxValue = std::numeric_limits<T>::max();
+    template<size_t N>
+    std::string encode(const std::array<T, N>& numbers) const;
+    template<typename... Numbers>
+    std::string encode(const std::tuple<Numbers...>& numbers) const;
+#if SQIDS_SPAN
+    template<typename U, size_t Extent, std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T>, int> = 0>
+    std::string encode(std::span<U, Extent> numbers) const;
+#endif
+
+    template<size_t N>
+    std::optional<std::array<T, N>> decode(std::string_view id) const;
+
+    template<typename Allocator, std::enable_if_t<std::is_same_v<typename Allocator::value_type, char>, int> = 0>
+    std::basic_string<char, std::char_traits<char>, Allocator> encode(const T* numbers, size_t count,
+                                                                      const Allocator& allocator) const;
+    template<typename Allocator, std::enable_if_t<std::is_same_v<typename Allocator::value_type, T>, int> = 0>
+    std::vector<T, Allocator> decode(std::string_view id, const Allocator& allocator) const;
+#if SQIDS_PMR
+    std::pmr::string encode(const T* numbers, size_t count, std::pmr::memory_resource* resource) const;
+    std::pmr::vector<T> decode(std::string_view id, std::pmr::memory_resource* resource) const;
+#endif
+
+    Result<size_t> tryEncodeTo(const T* numbers, size_t count, char* out, size_t capacity) const noexcept;
+    Result<std::string> tryEncode(const std::vector<T>& numbers) const;
+    Result<size_t> tryDecodeInto(std::string_view id, T* out, size_t capacity) const noexcept;
+    Result<std::vector<T>> tryDecode(std::string_view id) const;
+
+    size_t encodeTo(const T* numbers, size_t count, char* out, size_t capacity) const;
+    template<typename Allocator>
+    void encodeInto(const T* numbers, size_t count, std::basic_string<char, std::char_traits<char>, Allocator>& out) const;
+    template<typename Allocator>
+    void encodeInto(const std::vector<T>& numbers, std::basic_string<char, std::char_traits<char>, Allocator>& out) const;
+
+    size_t maxEncodedLength(size_t count) const;
+    size_t maxEncodedLength(size_t count, const T& max) const;
+    size_t encodedLength(const T* numbers, size_t count) const;
+    size_t encodedLength(const std::vector<T>& numbers) const;
+
+    size_t decodedCount(std::string_view id) const;
+
+    size_t decodeInto(std::string_view id, T* out, size_t capacity) const;
+
+    class LazyDecoder;
+
+    LazyDecoder decodeLazily(std::string_view id) const;
+    std::optional<T> decodeFirst(std::string_view id) const;
+    std::vector<T> decodePrefix(std::string_view id, size_t count) const;
+
+    void encodeBatch(const T* numbers, size_t count, size_t arity, EncodedBatch& out) const;
+    void decodeBatch(const std::string_view* ids, size_t count, DecodedBatch<T>& out) const;
+    void decodeBatch(const EncodedBatch& ids, DecodedBatch<T>& out) const;
+
+    size_t alphabetCacheBytes() const;
+    size_t memoryUsage() const;
+
+    const std::shared_ptr<const BlocklistMatcher>& blocklistMatcher() const;
+
+    static constexpr T maxValue = IntegerTraits<T>::max();
+
+protected:
+    Sqids(const AlphabetTables& tables, size_t maxDigits, std::shared_ptr<const BlocklistMatcher> blocklist,
+          const SqidsOptions& options);
 
 private:
+    using Traits = IntegerTraits<T>;
+
     struct Encoder
     {
-        Encoder(const Sqids<T>* _sqids, const std::vector<T>& _numbers);
+        Encoder(const Sqids<T>* _sqids, const T* _numbers, size_t _count, char* _out, size_t _capacity);
+
+        const Sqids<T>* const sqids;
+        const T* const numbers;
+        const size_t count;
+
+        char* const out;
+        const size_t capacity;
+        size_t length;
+
+        Result<size_t> run();
+
+        bool generate(size_t offset);
+        bool append(const char* chars, size_t n);
+
+#if defined(SQIDS_INSTRUMENTATION)
+        // Time spent checking for blocked words, over all attempts
+        std::chrono::nanoseconds blocklistTime { 0 };
+#endif
+    };
+
+    // Alphabets can't contain multibyte characters, so there can be no more
+    // than 128 unique characters
+    static constexpr size_t MAX_ALPHABET_SIZE = 128;
+
+    // IDs up to this length are mapped to alphabet positions in bulk before
+    // decoding; longer ones are looked up one character at a time
+    static constexpr size_t MAX_MAPPED_LENGTH = 256;
+
+    // The alphabet used while encoding or decoding an ID. It starts out as the
+    // re-arranged alphabet for an offset, and moves on to the next generation
+    // whenever it is shuffled. Generations found in the alphabet cache are
+    // used in place; the rest are shuffled in local storage.
+    struct WorkingAlphabet
+    {
+        WorkingAlphabet(const Sqids<T>* _sqids, size_t offset, bool _trackPositions);
+        WorkingAlphabet(const WorkingAlphabet&) = delete;
 
         const Sqids<T>* const sqids;
-        std::vector<T> numbers;
+        const bool trackPositions;
+
+        // The characters of the current generation, and the position of each
+        // character in it, indexed by its position in the original alphabet
+        const char* chars;
+        const uint8_t* positions;
+
+        size_t generation;
+
+        void shuffle();
+
+    private:
+        char    localChars[MAX_ALPHABET_SIZE];
+        uint8_t localPositions[MAX_ALPHABET_SIZE];
+    };
+
+    // Maps every byte to its position in an alphabet
+    using CharacterIndex = std::array<uint8_t, 256>;
+
+    static constexpr uint8_t NOT_IN_ALPHABET = AlphabetLookup::NOT_IN_ALPHABET;
+
+
+    static CharacterIndex indexAlphabet(const std::string& alphabet);
+
+    void shuffle(char* alphabet, size_t length) const;
+    void shuffle(char* alphabet, size_t length, uint8_t* positions) const;
+
+    size_t toId(T number, const char* alphabet, char* out, size_t capacity) const;
+    size_t digitCount(const T& number) const;
+    size_t idLength(size_t count, size_t digits) const;
+    T toNumber(std::string_view id, const uint8_t* positions, size_t alphabetSize) const;
+    T toNumber(const uint8_t* indices, size_t length, const uint8_t* positions, size_t alphabetSize) const;
+    bool isBlockedId(const char* id, size_t length) const;
+
+    template<typename Consumer>
+    Result<size_t> decodeNumbers(std::string_view id, Consumer&& consumer, bool canonical) const;
+    template<typename Consumer>
+    Result<size_t> readNumbers(std::string_view id, Consumer&& consumer, bool canonical) const;
+    static void reportDecode(const Result<size_t>& count);
+
+    bool isCanonicalNumber(T number, std::string_view digits, const char* alphabet) const;
+    bool isCanonicalPadding(std::string_view id, size_t numbersEnd, WorkingAlphabet& alphabet) const;
+    bool isCanonicalId(std::string_view id, size_t firstOffset) const;
+    bool isBlockedAttempt(std::string_view id, size_t offset) const;
+
+    [[noreturn]] void throwEncodeError(Error error) const;
+
+    template<typename Ids>
+    void decodeMany(const Ids& ids, size_t count, DecodedBatch<T>& out) const;
+
+    void initialize(const SqidsOptions& options);
+    void buildAlphabetCache(size_t depth);
+
+    std::string      _alphabet;
+    CharacterIndex   _alphabetIndex;
+    AlphabetLookup   _alphabetLookup;
+    std::shared_ptr<const BlocklistMatcher> _blocklist;
+    uint8_t          _minLength;
+    size_t           _maxDigits;
+    bool             _canonicalDecoding;
+
+    // Divide by the length of the alphabet, and by the number of digits
+    // (the alphabet without the `separator`)
+    Divider _alphabetDivider;
+    Divider _digitDivider;
+
+    // Divide by the largest power of the number of digits below 2^32, which
+    // splits numbers wider than 64 bits into chunks of `_chunkDigits` digits
+    Divider _chunkDivider;
+    size_t  _chunkDigits;
+
+    // Precomputed alphabets, `_alphabetCacheDepth` generations per offset
+    size_t               _alphabetCacheDepth;
+    std::vector<char>    _alphabetCache;
+    std::vector<uint8_t> _positionCache;
+
+    // The first generation for every offset, when it was computed ahead of
+    // time (see AlphabetTables). Used when there is no alphabet cache.
+    const char*    _rotations = nullptr;
+    const uint8_t* _rotationPositions = nullptr;
+};
+
+///
+/// @class Sqids::LazyDecoder
+///
+/// @brief Decodes the integers of an ID one at a time, as they are read.
+///
+/// Only the integers that are read get decoded, and the alphabet is only
+/// shuffled when moving on to the next one. Reading the first integers of
+/// an ID costs the same however many integers follow and however long the
+/// padding is, which suits routing by the leading integers.
+///
+/// The whole ID is checked for characters outside of the alphabet up front,
+/// so the integers read are always the first ones decode() returns. Invalid
+/// IDs have no integers, and error() tells why. Canonical decoding isn't
+/// applied, since it needs the whole ID.
+///
+/// Rejected IDs are reported to the instrumentation sink when the decoder is
+/// created. Valid IDs are reported as decoded when it's destroyed, with the
+/// number of integers read.
+///
+/// A decoder refers to the ID and to the instance that created it, and can't
+/// be copied.
+///
+/// @code
+/// for (auto number : sqids.decodeLazily(id)) {
+///     ...
+/// }
+/// @endcode
+///
+template<typename T>
+class Sqids<T>::LazyDecoder
+{
+public:
+    struct Sentinel
+    {
+    };
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit Iterator(LazyDecoder* decoder) : _decoder(decoder) { ++*this; }
+
+        const T& operator*() const { return _number; }
+
+        Iterator& operator++()
+        {
+            if (!_decoder->next(_number)) {
+                _decoder = nullptr;
+            }
+            return *this;
+        }
 
-        std::string run(unsigned int increment = 0);
+        bool operator==(Sentinel) const { return _decoder == nullptr; }
+        bool operator!=(Sentinel) const { return _decoder != nullptr; }
+
+    private:
+        LazyDecoder* _decoder;
+        T _number {};
     };
 
-    std::string lowercaseString(const std::string& input) const;
+    LazyDecoder(const Sqids<T>* sqids, std::string_view id);
+    LazyDecoder(const LazyDecoder&) = delete;
+    ~LazyDecoder();
+
+    bool next(T& number);
+
+    ///
+    /// @return Why the ID has no integers, or Error::None if it's valid
+    ///
+    Error error() const { return _error; }
+
+    Iterator begin() { return Iterator(this); }
+    Sentinel end() const { return Sentinel(); }
+
+private:
+    static size_t validate(const Sqids<T>* sqids, std::string_view id, Error& error);
 
-    void shuffle(std::string& alphabet) const;
+    const Sqids<T>* const _sqids;
+    const std::string_view _id;
+    Error _error;
+    WorkingAlphabet _alphabet;
 
-    std::string toId(T number, const std::string& alphabet) const;
-    T toNumber(const std::string& id, const std::string& alphabet) const;
-    bool isBlockedId(const std::string& id) const;
+    // Where the next integer starts, and whether the alphabet has to be
+    // shuffled before reading it
+    size_t _start;
+    bool _shufflePending;
 
-    std::string           _alphabet;
-    std::set<std::string> _blocklist;
-    uint8_t               _minLength;
+    // The number of integers read so far
+    size_t _count;
 };
 
 ///
@@ -173,12 +583,16 @@ inline constexpr std::vector<T> Sqids<T>::numbers(std::initializer_list<T>&& val
 }
 
 template<typename T>
-inline std::string Sqids<T>::lowercaseString(const std::string& input) const
+inline typename Sqids<T>::CharacterIndex Sqids<T>::indexAlphabet(const std::string& alphabet)
 {
-    std::string lowercaseString;
-    lowercaseString.resize(input.size());
-    std::transform(input.cbegin(), input.cend(), lowercaseString.begin(), ::tolower);
-    return lowercaseString;
+    CharacterIndex index;
+    index.fill(NOT_IN_ALPHABET);
+
+    for (size_t i = 0; i < alphabet.size(); i++) {
+        index[static_cast<unsigned char>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+
+    return index;
 }
 
 ///
@@ -194,48 +608,140 @@ inline std::string Sqids<T>::lowercaseString(const std::string& input) const
 template<typename T>
 Sqids<T>::Sqids(const SqidsOptions& options)
   : _alphabet(options.alphabet),
-    _minLength(options.minLength)
+    _minLength(options.minLength),
+    _canonicalDecoding(options.canonicalDecoding),
+    _alphabetCacheDepth(0)
 {
     const size_t alphabetSize = options.alphabet.size();
 
     // Alphabet cannot contain multibyte characters
     if (containsMultibyteCharacters(options.alphabet)) {
-        throw std::runtime_error("Alphabet cannot contain multibyte characters.");
+        SQIDS_THROW(std::runtime_error("Alphabet cannot contain multibyte characters."));
     }
 
     // Check the length of the alphabet
     if (alphabetSize < 3) {
-        throw std::runtime_error("Alphabet length must be at least 3.");
+        SQIDS_THROW(std::runtime_error("Alphabet length must be at least 3."));
     }
 
     // Check that all the characters in the alphabet are unique
     if (std::set<char>(options.alphabet.cbegin(), options.alphabet.cend()).size() != alphabetSize) {
-        throw std::runtime_error("Alphabet must not contain duplicate characters.");
+        SQIDS_THROW(std::runtime_error("Alphabet must not contain duplicate characters."));
     }
 
-    const std::string lowercaseAlphabet(lowercaseString(options.alphabet));
+    _alphabetDivider = Divider(alphabetSize);
+    _digitDivider = Divider(alphabetSize - 1);
 
-    // Clean up blocklist
-    for (const std::string& word : options.blocklist) {
-        // 1. Remove words with less than 3 characters
-        if (word.size() < 3) {
-            continue;
-        }
+    shuffle(&_alphabet[0], _alphabet.size());
 
-        const std::string lowercaseWord = lowercaseString(word);
+    _alphabetIndex = indexAlphabet(_alphabet);
 
-        // 2. Remove words that contain characters not in the alphabet
-        if (!std::all_of(lowercaseWord.cbegin(), lowercaseWord.cend(), [lowercaseAlphabet](auto ch) {
-            return lowercaseAlphabet.find(ch) != std::string::npos;
-        })) {
-            continue;
-        }
+    initialize(options);
+}
+
+///
+/// Construct an instance from an alphabet whose tables were computed ahead
+/// of time, such as by FixedSqids at compile time. Nothing is derived from
+/// the alphabet, except the alphabet cache if it's deeper than one
+/// generation.
+///
+/// @param tables     The tables of a validated alphabet, which must outlive
+///                   the instance
+/// @param maxDigits  The number of digits of `maxValue`
+/// @param blocklist  The blocklist, compiled for the alphabet
+/// @param options    All other options; `options.alphabet` and
+///                   `options.blocklist` are ignored
+///
+template<typename T>
+Sqids<T>::Sqids(const AlphabetTables& tables, size_t maxDigits, std::shared_ptr<const BlocklistMatcher> blocklist,
+                const SqidsOptions& options)
+  : _alphabet(tables.chars),
+    _alphabetIndex(*tables.index),
+    _alphabetLookup(*tables.lookup),
+    _blocklist(std::move(blocklist)),
+    _minLength(options.minLength),
+    _maxDigits(maxDigits),
+    _canonicalDecoding(options.canonicalDecoding),
+    _alphabetDivider(tables.alphabetDivider),
+    _digitDivider(tables.digitDivider),
+    _chunkDivider(tables.chunkDivider),
+    _chunkDigits(tables.chunkDigits),
+    _alphabetCacheDepth(0),
+    _rotations(tables.rotations),
+    _rotationPositions(tables.positions)
+{
+    // The first generation is already there for every offset
+    if (options.alphabetCacheDepth > 1) {
+        buildAlphabetCache(options.alphabetCacheDepth);
+    }
+}
+
+///
+/// Build everything else from the shuffled alphabet: the blocklist matcher,
+/// lookup tables and the alphabet cache.
+///
+template<typename T>
+void Sqids<T>::initialize(const SqidsOptions& options)
+{
+    const size_t alphabetSize = _alphabet.size();
+
+    // Compile the blocklist so that IDs can be checked in a single pass. The
+    // default blocklist is compiled once per alphabet and shared.
+    _blocklist = options.blocklist.compile(_alphabet);
+
+    _alphabetLookup = AlphabetLookup(_alphabetIndex);
+
+    // The number of digits needed for the largest number, which is encoded
+    // without the `separator` character
+    _maxDigits = 0;
+    for (T v = maxValue; !Traits::isZero(v); Traits::divide(v, _digitDivider)) {
+        _maxDigits++;
+    }
+
+    uint64_t chunk = alphabetSize - 1;
+    _chunkDigits = 1;
+    while (chunk * (alphabetSize - 1) < (uint64_t(1) << 32)) {
+        chunk *= alphabetSize - 1;
+        _chunkDigits++;
+    }
+    _chunkDivider = Divider(chunk);
+
+    if (options.alphabetCacheDepth > 0) {
+        buildAlphabetCache(options.alphabetCacheDepth);
+    }
+}
 
-        // 3. Convert words to lowercase
-        _blocklist.insert(lowercaseWord);
+///
+/// Precompute the first `depth` generations of the alphabet for every offset.
+///
+template<typename T>
+void Sqids<T>::buildAlphabetCache(size_t depth)
+{
+    const size_t alphabetSize = _alphabet.size();
+    const size_t tableSize = alphabetSize * depth * alphabetSize;
+    _alphabetCache.resize(tableSize);
+    _positionCache.resize(tableSize);
+
+    for (size_t offset = 0; offset < alphabetSize; offset++) {
+        // The cache isn't enabled yet, so this builds the alphabet on the fly
+        WorkingAlphabet alphabet(this, offset, true);
+        char* chars = &_alphabetCache[offset * depth * alphabetSize];
+        uint8_t* positions = &_positionCache[offset * depth * alphabetSize];
+
+        std::copy(alphabet.chars, alphabet.chars + alphabetSize, chars);
+        std::copy(alphabet.positions, alphabet.positions + alphabetSize, positions);
+
+        for (size_t generation = 1; generation < depth; generation++) {
+            std::copy(chars, chars + alphabetSize, chars + alphabetSize);
+            std::copy(positions, positions + alphabetSize, positions + alphabetSize);
+            chars += alphabetSize;
+            positions += alphabetSize;
+
+            shuffle(chars, alphabetSize, positions);
+        }
     }
 
-    shuffle(_alphabet);
+    _alphabetCacheDepth = depth;
 }
 
 template<typename T>
@@ -265,261 +771,1451 @@ inline bool Sqids<T>::containsMultibyteCharacters(const std::string& input) cons
 template<typename T>
 std::string Sqids<T>::encode(const std::vector<T>& numbers) const
 {
-    // If no numbers were passed, return an empty string
-    if (numbers.empty()) {
-        return "";
-    }
-
-    // Don't allow out-of-range numbers
-    for (auto it = numbers.cbegin(); it != numbers.cend(); ++it) {
-        if (*it < 0 || *it > maxValue) {
-            std::ostringstream stream;
-            stream << "Encoding supports numbers between 0 and " << maxValue;
-
-            throw std::runtime_error(stream.str());
-        }
-    }
-
-    return Encoder(this, numbers).run();
+    std::string id;
+    encodeInto(numbers.data(), numbers.size(), id);
+    return id;
 }
 
 ///
-/// Decode an ID back into a sequence of integers. This function will return
-/// an empty sequence in the following cases:
-///   - The ID is empty
-///   - An invalid ID is passed
-///   - A non-alphabet character is found in the ID
+/// Encode a fixed number of integers into an ID. The ID is generated in a
+/// buffer on the stack, so the only allocation is the returned string's,
+/// which short IDs avoid altogether.
 ///
-/// @param id  The ID to decode
-/// @return    The sequence of integers
+/// @throws std::runtime_error When encoding fails
+///
+/// @param numbers The integers to encode into an ID
+/// @return        The generated ID
 ///
 template<typename T>
-typename std::vector<T> Sqids<T>::decode(std::string_view id) const
+template<size_t N>
+std::string Sqids<T>::encode(const std::array<T, N>& numbers) const
 {
-    // If an empty string is given, return an empty sequence
-    if (id.empty()) {
-        return {};
-    }
-
-    // If a character is not in the alphabet, return an empty sequence
-    for (auto ch : id) {
-        if (_alphabet.find(ch) == std::string::npos) {
-            return {};
-        }
-    }
-
-    std::vector<T> numbers;
-
-    // First character is always the `prefix`
-    const auto prefix = id[0];
-
-    // `offset` is the semi-random position that was generated during encoding
-    const auto offset = _alphabet.find(prefix);
-
-    // Re-arrange alphabet back into it's original form
-    std::string alphabet(_alphabet.substr(offset) + _alphabet.substr(0, offset));
-
-    // Reverse alphabet
-    std::reverse(alphabet.begin(), alphabet.end());
-
-    // Remove the prefix character from the ID since it is not needed anymore
-    std::string slicedId(id.substr(1));
-
-    // Decode
-    while (slicedId.size() > 0) {
-        const auto separator = alphabet[0];
-
-        std::vector<std::string> chunks;
-        size_t start = 0,
-               end = 0;
-
-        // We need the first part to the left of the separator to decode the number
-        while ((end = slicedId.find(separator, start)) != std::string::npos) {
-            chunks.push_back(slicedId.substr(start, end - start));
-            start = end + 1;
-        }
-        chunks.push_back(slicedId.substr(start));
-
-        if (chunks.size() > 0) {
-            if (chunks[0].empty()) {
-                return numbers;
-            }
-
-            // Decode the number without using the `separator` character
-            numbers.push_back(toNumber(chunks[0], alphabet.substr(1)));
-
-            // If this ID has multiple numbers, shuffle the alphabet, just as
-            // the encoding function does
-            if (chunks.size() > 1) {
-                shuffle(alphabet);
-            }
-        }
-
-        // The `id` is now going to be everything to the right of the `separator`
-        slicedId.clear();
-        chunks.erase(chunks.begin());
-
-        const size_t chunksCount = chunks.size();
-        for (unsigned int i = 0; i < chunksCount; i++) {
-            slicedId += chunks[i];
-            if (i < chunksCount - 1) {
-                slicedId += separator;
-            }
-        }
-    }
+    // Every number has at most one digit per bit, and `minLength` is below 256
+    char buffer[std::max<size_t>(N * (sizeof(T) * CHAR_BIT + 1), UINT8_MAX)];
 
-    return numbers;
+    return std::string(buffer, encodeTo(numbers.data(), N, buffer, sizeof(buffer)));
 }
 
+///
+/// @overload
+///
+/// The elements of the tuple must convert to `T` without narrowing, for
+/// example `std::tuple<uint32_t, uint64_t>` for a `Sqids<uint64_t>`.
+///
 template<typename T>
-void Sqids<T>::shuffle(std::string& alphabet) const
+template<typename... Numbers>
+std::string Sqids<T>::encode(const std::tuple<Numbers...>& numbers) const
 {
-    const auto length = alphabet.size();
-
-    // In-place shuffle which always produces the same result, given the same
-    // alphabet
-    for (unsigned int i = 0, j = length - 1; j > 0; i++, j--) {
-        const auto r = (i * j + alphabet[i] + alphabet[j]) % length;
-        std::swap(alphabet[i], alphabet[r]);
-    }
+    return std::apply([this](const Numbers&... values) {
+        return encode(std::array<T, sizeof...(Numbers)> { values... });
+    }, numbers);
 }
 
+#if SQIDS_SPAN
+///
+/// @overload
+///
+/// The element type and extent are deduced, so that braced lists such as
+/// `encode({})` never match this overload and keep calling the
+/// `std::vector` one.
+///
 template<typename T>
-std::string Sqids<T>::toId(T number, const std::string& alphabet) const
+template<typename U, size_t Extent, std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T>, int>>
+std::string Sqids<T>::encode(std::span<U, Extent> numbers) const
 {
     std::string id;
-    const size_t alphabetLength = alphabet.size();
-
-    do {
-        id.append(1, alphabet[number % alphabetLength]);
-        number = number / alphabetLength;
-    } while (number > 0);
-
-    std::reverse(id.begin(), id.end());
-
+    encodeInto(numbers.data(), numbers.size(), id);
     return id;
 }
+#endif
 
+///
+/// Encode a sequence of integers into an ID, writing it directly into a
+/// caller-provided buffer. The ID is not null-terminated. No memory is
+/// allocated, unless encoding fails.
+///
+/// A buffer of maxEncodedLength() characters is always large enough.
+///
+/// @throws std::runtime_error When encoding fails
+/// @throws std::length_error  When the buffer is too small for the ID
+///
+/// @param numbers   The integers to encode into an ID
+/// @param count     The number of integers
+/// @param out       The buffer to write the ID into
+/// @param capacity  The size of the buffer
+/// @return          The length of the generated ID
+///
 template<typename T>
-T Sqids<T>::toNumber(const std::string& id, const std::string& alphabet) const
+size_t Sqids<T>::encodeTo(const T* numbers, size_t count, char* out, size_t capacity) const
 {
-    const size_t alphabetSize = alphabet.size();
-    T a = 0;
-
-    for (auto ch : id) {
-        a = a * alphabetSize + alphabet.find(ch);
+    const auto length = tryEncodeTo(numbers, count, out, capacity);
+    if (!length) {
+        throwEncodeError(length.error());
     }
 
-    return a;
+    return *length;
 }
 
+///
+/// Encode a sequence of integers into an ID, like encodeTo(), but report
+/// failures as errors instead of throwing. No memory is allocated.
+///
+/// @param numbers   The integers to encode into an ID
+/// @param count     The number of integers
+/// @param out       The buffer to write the ID into
+/// @param capacity  The size of the buffer
+/// @return          The length of the generated ID, or Error::OutOfRange,
+///                  Error::MaxAttempts or Error::BufferTooSmall
+///
 template<typename T>
-bool Sqids<T>::isBlockedId(const std::string& id) const
+Result<size_t> Sqids<T>::tryEncodeTo(const T* numbers, size_t count, char* out, size_t capacity) const noexcept
 {
-    const size_t idLength = id.size();
-
-    auto lowercaseId(lowercaseString(id));
+    // If no numbers were passed, return an empty string
+    if (count == 0) {
+        return size_t(0);
+    }
 
-    for (const std::string& word : _blocklist) {
-        const size_t wordLength = word.size();
-        // No point in checking words that are longer than the ID
-        if (wordLength <= idLength) {
-            if (idLength <= 3 || wordLength <= 3) {
-                // Short words have to match completely; otherwise, too many matches
-                if (lowercaseId == word) {
-                    return true;
-                }
-            } else if (std::any_of(word.cbegin(), word.cend(), ::isdigit)) {
-                // Words with leet speak replacements are visible mostly at the
-                // ends of the ID
-                if (lowercaseId.find(word) == 0 || lowercaseId.rfind(word) == idLength - wordLength) {
-                    return true;
-                }
-            } else if (lowercaseId.find(word) != std::string::npos) {
-                // Otherwise, check for blocked word anywhere in the string
-                return true;
-            }
+    // Don't allow out-of-range numbers
+    for (size_t i = 0; i < count; i++) {
+        if (Traits::isNegative(numbers[i]) || numbers[i] > maxValue) {
+            return Error::OutOfRange;
+        }
+    }
+
+    return Encoder(this, numbers, count, out, capacity).run();
+}
+
+///
+/// Encode a sequence of integers into an ID, like encode(), but report
+/// failures as errors instead of throwing. Memory is only allocated for an
+/// ID that was generated successfully.
+///
+/// IDs longer than 256 characters are generated in a buffer kept by each
+/// thread, which grows to the longest such ID the thread has encoded.
+///
+/// @param numbers The integers to encode into an ID
+/// @return        The generated ID, or Error::OutOfRange or
+///                Error::MaxAttempts
+///
+template<typename T>
+Result<std::string> Sqids<T>::tryEncode(const std::vector<T>& numbers) const
+{
+    // Check the numbers before anything is allocated, measuring the ID on the
+    // way, like encodedLength()
+    size_t digits = 0;
+    for (const T& number : numbers) {
+        if (Traits::isNegative(number) || number > maxValue) {
+            return Error::OutOfRange;
+        }
+        digits += digitCount(number);
+    }
+    const size_t length = idLength(numbers.size(), digits);
+
+    // IDs are generated in a scratch buffer, and copied once they're known
+    // not to be blocked
+    char buffer[256];
+    char* scratch = buffer;
+
+    if (length > sizeof(buffer)) {
+        static thread_local std::string longIds;
+        if (longIds.size() < length) {
+            longIds.resize(length);
+        }
+        scratch = &longIds[0];
+    }
+
+    const auto encoded = tryEncodeTo(numbers.data(), numbers.size(), scratch, length);
+    if (!encoded) {
+        return encoded.error();
+    }
+
+    return std::string(scratch, *encoded);
+}
+
+template<typename T>
+void Sqids<T>::throwEncodeError(Error error) const
+{
+    switch (error) {
+        case Error::OutOfRange:
+            SQIDS_THROW(std::runtime_error("Encoding supports numbers between 0 and " + Traits::toString(maxValue)));
+        case Error::BufferTooSmall:
+            SQIDS_THROW(std::length_error(errorMessage(error)));
+        default:
+            SQIDS_THROW(std::runtime_error(errorMessage(error)));
+    }
+}
+
+///
+/// Encode a sequence of integers into an ID, replacing the contents of `out`.
+/// Once `out` has grown large enough, its storage is reused and no memory is
+/// allocated.
+///
+/// @throws std::runtime_error When encoding fails
+///
+/// @param numbers  The integers to encode into an ID
+/// @param count    The number of integers
+/// @param out      The string that receives the generated ID, which can use
+///                 any allocator
+///
+template<typename T>
+template<typename Allocator>
+void Sqids<T>::encodeInto(const T* numbers, size_t count,
+                          std::basic_string<char, std::char_traits<char>, Allocator>& out) const
+{
+    out.resize(maxEncodedLength(count));
+    out.resize(encodeTo(numbers, count, &out[0], out.size()));
+}
+
+///
+/// @overload
+///
+template<typename T>
+template<typename Allocator>
+void Sqids<T>::encodeInto(const std::vector<T>& numbers,
+                          std::basic_string<char, std::char_traits<char>, Allocator>& out) const
+{
+    encodeInto(numbers.data(), numbers.size(), out);
+}
+
+///
+/// The memory used by the alphabet cache, in bytes.
+///
+/// @see SqidsOptions::alphabetCacheDepth
+///
+template<typename T>
+size_t Sqids<T>::alphabetCacheBytes() const
+{
+    return _alphabetCache.size() + _positionCache.size();
+}
+
+///
+/// An estimate of the memory used by this instance, in bytes. The blocklist
+/// matcher is included even when it's shared with other instances; subtract
+/// `blocklistMatcher()->memoryUsage()` to count it separately.
+///
+template<typename T>
+size_t Sqids<T>::memoryUsage() const
+{
+    return sizeof(*this) + _alphabet.capacity() + _alphabetCache.capacity() + _positionCache.capacity() +
+           _blocklist->memoryUsage();
+}
+
+///
+/// @return The compiled blocklist, which may be shared with other instances
+///         using the same words and alphabet characters (see Blocklist)
+///
+template<typename T>
+const std::shared_ptr<const BlocklistMatcher>& Sqids<T>::blocklistMatcher() const
+{
+    return _blocklist;
+}
+
+///
+/// The maximum length of an ID encoding `count` numbers, taking `minLength`
+/// into account.
+///
+/// @param count  The number of integers to encode
+/// @return       The length of the longest possible ID
+///
+template<typename T>
+size_t Sqids<T>::maxEncodedLength(size_t count) const
+{
+    return idLength(count, count * _maxDigits);
+}
+
+///
+/// The maximum length of an ID encoding `count` numbers that are all at
+/// most `max`, taking `minLength` into account. This is what a database
+/// column or fixed-width field needs to hold every ID of a known range.
+///
+/// @throws std::runtime_error When `max` is out of range
+///
+/// @param count  The number of integers to encode
+/// @param max    The largest integer that will be encoded
+/// @return       The length of the longest possible ID
+///
+template<typename T>
+size_t Sqids<T>::maxEncodedLength(size_t count, const T& max) const
+{
+    if (Traits::isNegative(max) || max > maxValue) {
+        throwEncodeError(Error::OutOfRange);
+    }
+
+    return idLength(count, count * digitCount(max));
+}
+
+///
+/// The exact length of the ID that encode() generates for a sequence of
+/// integers, computed from their number of digits without generating it.
+///
+/// IDs re-generated because of the blocklist are as long as the first one,
+/// so the length is exact even then. The one thing it can't predict is
+/// whether every attempt is blocked, in which case encode() throws.
+///
+/// @throws std::runtime_error When a number is out of range
+///
+/// @param numbers  The integers to encode
+/// @param count    The number of integers
+/// @return         The length of the ID
+///
+template<typename T>
+size_t Sqids<T>::encodedLength(const T* numbers, size_t count) const
+{
+    size_t digits = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (Traits::isNegative(numbers[i]) || numbers[i] > maxValue) {
+            throwEncodeError(Error::OutOfRange);
+        }
+        digits += digitCount(numbers[i]);
+    }
+
+    return idLength(count, digits);
+}
+
+///
+/// @overload
+///
+template<typename T>
+size_t Sqids<T>::encodedLength(const std::vector<T>& numbers) const
+{
+    return encodedLength(numbers.data(), numbers.size());
+}
+
+///
+/// The number of integers decode() returns for an ID, without storing them,
+/// so that room can be made for them beforehand. Unlike decoding, counting
+/// isn't reported to the instrumentation sink. No memory is allocated.
+///
+/// @param id  The ID to decode
+/// @return    The number of integers in the ID, or 0 in the same cases where
+///            decode() returns an empty sequence
+///
+template<typename T>
+size_t Sqids<T>::decodedCount(std::string_view id) const
+{
+    return readNumbers(id, [](T) {
+    }, _canonicalDecoding).value_or(0);
+}
+
+///
+/// Decode an ID back into a sequence of integers. This function will return
+/// an empty sequence in the following cases:
+///   - The ID is empty
+///   - An invalid ID is passed
+///   - A non-alphabet character is found in the ID
+///
+/// @param id  The ID to decode
+/// @return    The sequence of integers
+///
+template<typename T>
+typename std::vector<T> Sqids<T>::decode(std::string_view id) const
+{
+    std::vector<T> numbers;
+
+    const auto count = decodeNumbers(id, [&numbers](T number) {
+        numbers.push_back(number);
+    }, _canonicalDecoding);
+    if (!count) {
+        numbers.clear();
+    }
+
+    return numbers;
+}
+
+///
+/// Decode an ID that holds exactly `N` integers, without allocating memory.
+///
+/// @code
+/// if (auto numbers = sqids.decode<2>(id)) {
+///     auto [shard, row] = *numbers;
+/// }
+/// @endcode
+///
+/// @param id  The ID to decode
+/// @return    The integers, or nothing if the ID doesn't hold exactly `N`
+///            integers, including in all the cases where decode() returns
+///            an empty sequence
+///
+template<typename T>
+template<size_t N>
+std::optional<std::array<T, N>> Sqids<T>::decode(std::string_view id) const
+{
+    std::array<T, N> numbers;
+
+    if (decodeInto(id, numbers.data(), N) != N) {
+        return std::nullopt;
+    }
+
+    return numbers;
+}
+
+///
+/// Start decoding an ID lazily, one integer at a time.
+///
+/// @param id  The ID to decode, which must outlive the decoder
+/// @return    A decoder over the integers of the ID
+///
+template<typename T>
+typename Sqids<T>::LazyDecoder Sqids<T>::decodeLazily(std::string_view id) const
+{
+    return LazyDecoder(this, id);
+}
+
+///
+/// Decode only the first integer of an ID, without decoding the rest of it.
+///
+/// @param id  The ID to decode
+/// @return    The first integer, or nothing in the cases where decode()
+///            returns an empty sequence
+///
+template<typename T>
+std::optional<T> Sqids<T>::decodeFirst(std::string_view id) const
+{
+    // Whether an ID is canonical depends on all of it
+    if (_canonicalDecoding) {
+        const auto numbers = decode(id);
+        return numbers.empty() ? std::nullopt : std::optional<T>(numbers[0]);
+    }
+
+    LazyDecoder decoder(this, id);
+
+    T number {};
+    if (!decoder.next(number)) {
+        return std::nullopt;
+    }
+
+    return number;
+}
+
+///
+/// Decode only the first `count` integers of an ID, without decoding the
+/// rest of it.
+///
+/// @param id     The ID to decode
+/// @param count  The number of integers to decode
+/// @return       The first `count` integers, or all of them if there are
+///               fewer; an empty sequence in the cases where decode() returns
+///               one
+///
+template<typename T>
+std::vector<T> Sqids<T>::decodePrefix(std::string_view id, size_t count) const
+{
+    if (_canonicalDecoding) {
+        auto numbers = decode(id);
+        numbers.resize(std::min(count, numbers.size()));
+        return numbers;
+    }
+
+    LazyDecoder decoder(this, id);
+
+    // Every integer takes at least one character
+    std::vector<T> numbers;
+    numbers.reserve(std::min(count, id.size()));
+
+    T number {};
+    while (numbers.size() < count && decoder.next(number)) {
+        numbers.push_back(number);
+    }
+
+    return numbers;
+}
+
+///
+/// Encode a sequence of integers into an ID, allocating the ID with
+/// `allocator`, such as a `std::pmr::polymorphic_allocator<char>` backed by
+/// a per-request arena. No other memory is allocated.
+///
+/// The ID is allocated once, at its final size, so arenas that never free
+/// memory don't keep a larger first attempt. Short IDs are generated on the
+/// stack first; longer ones straight into their storage, whose length is
+/// computed beforehand.
+///
+/// @throws std::runtime_error When encoding fails
+///
+/// @param numbers    The integers to encode into an ID
+/// @param count      The number of integers
+/// @param allocator  An allocator of `char`
+/// @return           The generated ID
+///
+template<typename T>
+template<typename Allocator, std::enable_if_t<std::is_same_v<typename Allocator::value_type, char>, int>>
+std::basic_string<char, std::char_traits<char>, Allocator> Sqids<T>::encode(const T* numbers, size_t count,
+                                                                            const Allocator& allocator) const
+{
+    using String = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+    char buffer[256];
+    const size_t maxLength = maxEncodedLength(count);
+
+    if (maxLength <= sizeof(buffer)) {
+        return String(buffer, encodeTo(numbers, count, buffer, sizeof(buffer)), allocator);
+    }
+
+    // Longer IDs are generated straight into their storage, which is
+    // allocated at the exact length encodedLength() predicts
+    String id(encodedLength(numbers, count), '\0', allocator);
+    encodeTo(numbers, count, &id[0], id.size());
+    return id;
+}
+
+///
+/// Decode an ID back into a sequence of integers, allocating them with
+/// `allocator`, such as a `std::pmr::polymorphic_allocator<T>` backed by a
+/// per-request arena. No other memory is allocated.
+///
+/// Like encode(), the integers are decoded on the stack first, so that the
+/// sequence is allocated once, at its final size.
+///
+/// @param id         The ID to decode
+/// @param allocator  An allocator of `T`
+/// @return           The integers, or an empty sequence in the same cases
+///                   as decode()
+///
+template<typename T>
+template<typename Allocator, std::enable_if_t<std::is_same_v<typename Allocator::value_type, T>, int>>
+std::vector<T, Allocator> Sqids<T>::decode(std::string_view id, const Allocator& allocator) const
+{
+    T buffer[16];
+    size_t count = 0;
+
+    const auto decoded = decodeNumbers(id, [&buffer, &count](T number) {
+        if (count < std::size(buffer)) {
+            buffer[count] = number;
+        }
+        count++;
+    }, _canonicalDecoding);
+    if (!decoded) {
+        count = 0;
+    }
+
+    if (count <= std::size(buffer)) {
+        return std::vector<T, Allocator>(buffer, buffer + count, allocator);
+    }
+
+    // Longer sequences are read again, straight into their storage. The ID
+    // has already been checked, and reported to the instrumentation sink.
+    std::vector<T, Allocator> numbers(count, T(), allocator);
+    size_t i = 0;
+    readNumbers(id, [&numbers, &i](T number) {
+        numbers[i++] = number;
+    }, false);
+    return numbers;
+}
+
+#if SQIDS_PMR
+///
+/// Encode a sequence of integers into an ID allocated from `resource`.
+///
+/// @throws std::runtime_error When encoding fails
+///
+/// @param numbers   The integers to encode into an ID
+/// @param count     The number of integers
+/// @param resource  The memory resource to allocate the ID from
+/// @return          The generated ID
+///
+template<typename T>
+std::pmr::string Sqids<T>::encode(const T* numbers, size_t count, std::pmr::memory_resource* resource) const
+{
+    return encode(numbers, count, std::pmr::polymorphic_allocator<char>(resource));
+}
+
+///
+/// Decode an ID back into a sequence of integers allocated from `resource`.
+///
+/// @param id        The ID to decode
+/// @param resource  The memory resource to allocate the integers from
+/// @return          The integers, or an empty sequence in the same cases as
+///                  decode()
+///
+template<typename T>
+std::pmr::vector<T> Sqids<T>::decode(std::string_view id, std::pmr::memory_resource* resource) const
+{
+    return decode(id, std::pmr::polymorphic_allocator<T>(resource));
+}
+#endif
+
+///
+/// Decode an ID back into a sequence of integers, writing them into a
+/// caller-provided array. No memory is allocated.
+///
+/// Like `snprintf`, the function returns the number of integers in the ID,
+/// even if there wasn't enough room for all of them; only the first
+/// `capacity` integers are written. Zero is returned in the same cases where
+/// decode() returns an empty sequence.
+///
+/// @param id        The ID to decode
+/// @param out       The array to write the integers into
+/// @param capacity  The size of the array
+/// @return          The number of integers in the ID
+///
+template<typename T>
+size_t Sqids<T>::decodeInto(std::string_view id, T* out, size_t capacity) const
+{
+    return tryDecodeInto(id, out, capacity).value_or(0);
+}
+
+///
+/// Decode an ID like decodeInto(), but tell apart the reasons why an ID
+/// holds no integers. No memory is allocated.
+///
+/// @param id        The ID to decode
+/// @param out       The array to write the integers into
+/// @param capacity  The size of the array
+/// @return          The number of integers in the ID, which may be larger
+///                  than `capacity`, or Error::EmptyId or
+///                  Error::InvalidCharacter
+///
+template<typename T>
+Result<size_t> Sqids<T>::tryDecodeInto(std::string_view id, T* out, size_t capacity) const noexcept
+{
+    size_t count = 0;
+
+    return decodeNumbers(id, [out, capacity, &count](T number) {
+        if (count < capacity) {
+            out[count] = number;
+        }
+        count++;
+    }, _canonicalDecoding);
+}
+
+///
+/// Decode an ID like decode(), but tell apart the reasons why an ID holds
+/// no integers. Memory is only allocated for the integers of a valid ID.
+///
+/// @param id  The ID to decode
+/// @return    The integers, or Error::EmptyId or Error::InvalidCharacter
+///
+template<typename T>
+Result<std::vector<T>> Sqids<T>::tryDecode(std::string_view id) const
+{
+    std::vector<T> numbers;
+
+    const auto count = decodeNumbers(id, [&numbers](T number) {
+        numbers.push_back(number);
+    }, _canonicalDecoding);
+    if (!count) {
+        return count.error();
+    }
+
+    return numbers;
+}
+
+///
+/// Encode many IDs with the same number of integers each, packing them into
+/// `out`. This gives the same IDs as calling encode() for each of them, but
+/// the output buffer is allocated once for the whole batch, and its storage
+/// is reused when `out` is passed again.
+///
+/// If encoding fails, an exception is thrown and the contents of `out` are
+/// unspecified.
+///
+/// @throws std::runtime_error When encoding fails
+///
+/// @param numbers  The integers to encode, `arity` for each ID
+/// @param count    The number of IDs to generate
+/// @param arity    The number of integers in each ID
+/// @param out      Receives the generated IDs
+///
+template<typename T>
+void Sqids<T>::encodeBatch(const T* numbers, size_t count, size_t arity, EncodedBatch& out) const
+{
+    const size_t maxLength = maxEncodedLength(arity);
+
+    out.buffer.resize(count * maxLength);
+    out.offsets.resize(count + 1);
+    out.offsets[0] = 0;
+
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) {
+        length += encodeTo(numbers + i * arity, arity, &out.buffer[length], maxLength);
+        out.offsets[i + 1] = length;
+    }
+
+    out.buffer.resize(length);
+}
+
+///
+/// Decode many IDs, packing their integers into `out`. This gives the same
+/// numbers as calling decode() for each of them, but they are collected into
+/// a single array whose storage is reused when `out` is passed again.
+///
+/// @param ids    The IDs to decode
+/// @param count  The number of IDs
+/// @param out    Receives the decoded integers
+///
+template<typename T>
+void Sqids<T>::decodeBatch(const std::string_view* ids, size_t count, DecodedBatch<T>& out) const
+{
+    decodeMany(ids, count, out);
+}
+
+///
+/// @overload
+///
+template<typename T>
+void Sqids<T>::decodeBatch(const EncodedBatch& ids, DecodedBatch<T>& out) const
+{
+    decodeMany(ids, ids.size(), out);
+}
+
+template<typename T>
+template<typename Ids>
+void Sqids<T>::decodeMany(const Ids& ids, size_t count, DecodedBatch<T>& out) const
+{
+    out.numbers.clear();
+    out.offsets.resize(count + 1);
+    out.offsets[0] = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const auto decoded = decodeNumbers(ids[i], [&out](T number) {
+            out.numbers.push_back(number);
+        }, _canonicalDecoding);
+
+        // Drop the numbers of a non-canonical ID
+        if (!decoded) {
+            out.numbers.resize(out.offsets[i]);
+        }
+        out.offsets[i + 1] = out.numbers.size();
+    }
+}
+
+///
+/// Walk an ID once, passing each decoded integer to `consumer`, and report
+/// the outcome to the instrumentation sink. If `canonical` is set, and the
+/// ID turns out not to be canonical, the integers passed so far must be
+/// discarded. No memory is allocated.
+///
+/// @return The number of integers decoded, or why the ID was rejected
+///
+template<typename T>
+template<typename Consumer>
+Result<size_t> Sqids<T>::decodeNumbers(std::string_view id, Consumer&& consumer, bool canonical) const
+{
+    const auto count = readNumbers(id, std::forward<Consumer>(consumer), canonical);
+    reportDecode(count);
+    return count;
+}
+
+///
+/// Report the outcome of decoding an ID to the instrumentation sink.
+///
+template<typename T>
+inline void Sqids<T>::reportDecode(const Result<size_t>& count)
+{
+#if defined(SQIDS_INSTRUMENTATION)
+    if (count) {
+        SQIDS_INSTRUMENT(decoded(*count));
+        return;
+    }
+
+    switch (count.error()) {
+    case Error::EmptyId:
+        SQIDS_INSTRUMENT(decodeRejected(DecodeRejection::EmptyId));
+        break;
+    case Error::InvalidCharacter:
+        SQIDS_INSTRUMENT(decodeRejected(DecodeRejection::InvalidCharacter));
+        break;
+    case Error::NonCanonical:
+        SQIDS_INSTRUMENT(decodeRejected(DecodeRejection::NonCanonical));
+        break;
+    default:
+        break;
+    }
+#else
+    (void)count;
+#endif
+}
+
+///
+/// Walk an ID like decodeNumbers(), without reporting anything, for checks
+/// that decode an ID again.
+///
+template<typename T>
+template<typename Consumer>
+Result<size_t> Sqids<T>::readNumbers(std::string_view id, Consumer&& consumer, bool canonical) const
+{
+    // If an empty string is given, return an empty sequence
+    if (id.empty()) {
+        return Error::EmptyId;
+    }
+
+    // First character is always the `prefix`
+    const auto prefix = id[0];
+
+    // `offset` is the semi-random position that was generated during encoding
+    const auto offset = _alphabetIndex[static_cast<unsigned char>(prefix)];
+
+    // If a character is not in the alphabet, return an empty sequence. Most
+    // IDs are short enough to also look up the position of every character
+    // in the same pass.
+    uint8_t indices[MAX_MAPPED_LENGTH];
+    const bool mapped = id.size() <= MAX_MAPPED_LENGTH;
+
+    if (offset == NOT_IN_ALPHABET ||
+        !(mapped ? _alphabetLookup.map(id.data(), id.size(), indices)
+                 : _alphabetLookup.validate(id.data(), id.size()))) {
+        return Error::InvalidCharacter;
+    }
+
+    const size_t alphabetSize = _alphabet.size();
+
+    // Re-arrange alphabet back into it's original form. Also keep track of
+    // where each character is in the alphabet, so that digits can be looked
+    // up in constant time.
+    WorkingAlphabet alphabet(this, offset, true);
+
+    size_t count = 0;
+
+    // Skip the prefix character since it is not needed anymore
+    size_t start = 1;
+
+    // For canonical decoding: the offset encode() would start from, less the
+    // number of integers, whether all digits are canonical so far, and where
+    // the last number ends
+    size_t expectedOffset = 0;
+    bool canonicalDigits = true;
+    size_t numbersEnd = start;
+
+    // Decode
+    while (start < id.size()) {
+        const auto separator = alphabet.chars[0];
+
+        // We need the part to the left of the separator to decode the number
+        size_t end = id.find(separator, start);
+        const bool hasSeparator = (end != std::string_view::npos);
+        if (!hasSeparator) {
+            end = id.size();
+        }
+
+        // Two separators next to each other mean the rest are junk characters
+        if (end == start) {
+            break;
+        }
+
+        // Decode the number without using the `separator` character
+        const T number = mapped ? toNumber(indices + start, end - start, alphabet.positions, alphabetSize - 1)
+                                : toNumber(id.substr(start, end - start), alphabet.positions, alphabetSize - 1);
+
+        if (canonical) {
+            expectedOffset += count + _alphabet[Traits::remainder(number, _alphabetDivider)];
+            canonicalDigits = canonicalDigits && isCanonicalNumber(number, id.substr(start, end - start),
+                                                                   alphabet.chars + 1);
+            numbersEnd = end;
+        }
+
+        consumer(number);
+        count++;
+
+        // If this ID has multiple numbers, shuffle the alphabet, just as
+        // the encoding function does
+        if (hasSeparator) {
+            alphabet.shuffle();
         }
+
+        // The `id` is now going to be everything to the right of the `separator`
+        start = end + 1;
     }
 
-    return false;
+    if (canonical) {
+        // Everything but the prefix matches what encode() generates at the
+        // offset of the prefix. If that's the offset encode() starts from,
+        // the ID is canonical unless it's blocked; otherwise, all attempts
+        // before it must have been blocked, which only a full encode() can
+        // tell.
+        const size_t firstOffset = _alphabetDivider.remainder(expectedOffset + count);
+        const bool valid = count > 0 && canonicalDigits && isCanonicalPadding(id, numbersEnd, alphabet) &&
+                           (firstOffset == offset ? !isBlockedId(id.data(), id.size())
+                                                  : isCanonicalId(id, firstOffset));
+
+        if (!valid) {
+            return Error::NonCanonical;
+        }
+    }
+
+    return count;
 }
 
+///
+/// Check that `digits`, which decoded to `number`, are the digits toId()
+/// writes for it: without leading zeros, and without overflowing `T`.
+///
 template<typename T>
-Sqids<T>::Encoder::Encoder(const Sqids<T>* _sqids, const std::vector<T>& _numbers)
-  : sqids(_sqids),
-    numbers(_numbers)
+bool Sqids<T>::isCanonicalNumber(T number, std::string_view digits, const char* alphabet) const
 {
+    if (digits.size() > 1 && digits[0] == alphabet[0]) {
+        return false;
+    }
+
+    // Numbers with fewer digits than `maxValue` can't overflow
+    if (digits.size() < _maxDigits) {
+        return true;
+    }
+    if (digits.size() > _maxDigits) {
+        return false;
+    }
+
+    char buffer[sizeof(T) * CHAR_BIT];
+    const size_t length = toId(number, alphabet, buffer, sizeof(buffer));
+
+    return digits == std::string_view(buffer, length);
 }
 
+///
+/// Check that an ID whose numbers end at `numbersEnd` either ends there,
+/// or is padded to `minLength` with the characters encode() appends.
+/// `alphabet` is the alphabet decoding ended with, which is shuffled.
+///
 template<typename T>
-std::string Sqids<T>::Encoder::run(unsigned int increment)
+bool Sqids<T>::isCanonicalPadding(std::string_view id, size_t numbersEnd, WorkingAlphabet& alphabet) const
 {
-    const size_t alphabetSize = sqids->_alphabet.size();
+    if (numbersEnd == id.size()) {
+        return numbersEnd >= _minLength;
+    }
+
+    if (numbersEnd >= _minLength || id.size() != _minLength) {
+        return false;
+    }
+
+    // Decoding already moved past the separator at `numbersEnd`, and
+    // shuffled the alphabet like encode() does before the first padding
+    const size_t alphabetSize = _alphabet.size();
+    for (size_t start = numbersEnd + 1; start < id.size();) {
+        const size_t n = std::min(id.size() - start, alphabetSize);
+        if (id.compare(start, n, alphabet.chars, n) != 0) {
+            return false;
+        }
+
+        start += n;
+        if (start < id.size()) {
+            alphabet.shuffle();
+        }
+    }
+
+    return true;
+}
 
-    if (increment > alphabetSize) {
-        throw std::runtime_error("Reached max attempts to re-generate the ID.");
+///
+/// Check that an ID, which is what encode() generates at the offset of its
+/// prefix, is what encode() returns for its numbers when it starts from
+/// `firstOffset`: the ID isn't blocked, and all the attempts before it were.
+///
+template<typename T>
+bool Sqids<T>::isCanonicalId(std::string_view id, size_t firstOffset) const
+{
+    if (isBlockedId(id.data(), id.size())) {
+        return false;
     }
 
-    // Get a semi-random offset from input numbers
-    auto a = numbers.size();
+    const size_t alphabetSize = _alphabet.size();
+    const size_t offset = _alphabetIndex[static_cast<unsigned char>(id[0])];
 
-    for (unsigned int i = 0; i < numbers.size(); i++) {
-        const T v = numbers[i];
-        a += i + sqids->_alphabet[v % alphabetSize];
+    for (size_t attempt = firstOffset; attempt != offset; attempt = (attempt + 1 == alphabetSize) ? 0 : attempt + 1) {
+        if (!isBlockedAttempt(id, attempt)) {
+            return false;
+        }
     }
 
-    const auto offset = (a + increment) % alphabetSize;
+    return true;
+}
+
+///
+/// Check whether the ID encode() generates at `offset` for the numbers of
+/// `id` is blocked. The ID is generated a few characters at a time and
+/// checked as it goes, so no memory is allocated, however long it is.
+///
+template<typename T>
+bool Sqids<T>::isBlockedAttempt(std::string_view id, size_t offset) const
+{
+    BlocklistMatcher::Scanner scanner(*_blocklist);
 
-    // Re-arrange alphabet so that second-half goes in front of the first-half
-    std::string alphabet(sqids->_alphabet.substr(offset) + sqids->_alphabet.substr(0, offset));
+    // Follows Encoder::generate(), starting with the `prefix`
+    WorkingAlphabet alphabet(this, offset, false);
+    scanner.feed(&_alphabet[offset], 1);
+    size_t length = 1;
 
-    // `prefix` is the first character in the generated ID, used for randomization
-    const auto prefix = alphabet[0];
+    readNumbers(id, [this, &scanner, &alphabet, &length](T number) {
+        if (scanner.matched()) {
+            return;
+        }
 
-    // Reverse alphabet
-    std::reverse(alphabet.begin(), alphabet.end());
+        if (length > 1) {
+            scanner.feed(alphabet.chars, 1);
+            alphabet.shuffle();
+            length++;
+        }
 
-    // The final ID will always have the `prefix` character at the beginning
-    std::string id = { prefix };
+        char digits[sizeof(T) * CHAR_BIT];
+        const size_t n = toId(number, alphabet.chars + 1, digits, sizeof(digits));
+        scanner.feed(digits, n);
+        length += n;
+    }, false);
+
+    if (_minLength > length && !scanner.matched()) {
+        scanner.feed(alphabet.chars, 1);
+        length++;
+
+        while (_minLength > length) {
+            alphabet.shuffle();
+            const size_t n = std::min<size_t>(_minLength - length, _alphabet.size());
+            scanner.feed(alphabet.chars, n);
+            length += n;
+        }
+    }
 
-    // Encode the input array
-    for (auto it = numbers.cbegin(); it != numbers.cend(); ++it) {
+    return scanner.finish();
+}
+
+template<typename T>
+void Sqids<T>::shuffle(char* alphabet, size_t length) const
+{
+    // In-place shuffle which always produces the same result, given the same
+    // alphabet. `length` is always the length of the alphabet, so the divider
+    // for it can be used.
+    for (unsigned int i = 0, j = length - 1; j > 0; i++, j--) {
+        const auto r = _alphabetDivider.remainder(i * j + alphabet[i] + alphabet[j]);
+        std::swap(alphabet[i], alphabet[r]);
+    }
+}
+
+///
+/// @overload
+///
+/// Also updates `positions`, which holds the position of every character in
+/// `alphabet`, indexed by its position in the original alphabet.
+///
+template<typename T>
+void Sqids<T>::shuffle(char* alphabet, size_t length, uint8_t* positions) const
+{
+    for (unsigned int i = 0, j = length - 1; j > 0; i++, j--) {
+        const auto r = _alphabetDivider.remainder(i * j + alphabet[i] + alphabet[j]);
+        std::swap(alphabet[i], alphabet[r]);
+
+        positions[_alphabetIndex[static_cast<unsigned char>(alphabet[i])]] = static_cast<uint8_t>(i);
+        positions[_alphabetIndex[static_cast<unsigned char>(alphabet[r])]] = static_cast<uint8_t>(r);
+    }
+}
+
+///
+/// Write the digits of `number` into `out`, using `alphabet` as the digits.
+/// The alphabet has as many characters as the divisor of `_digitDivider`.
+///
+/// @return The number of digits written, or 0 if `capacity` is too small
+///         for them
+///
+template<typename T>
+size_t Sqids<T>::toId(T number, const char* alphabet, char* out, size_t capacity) const
+{
+    // Digits are produced from the least significant one, so fill the buffer
+    // from the end
+    char digits[sizeof(T) * CHAR_BIT];
+    char* const end = digits + sizeof(digits);
+    char* first = end;
+
+    // Numbers wider than 64 bits are divided a few digits at a time, until
+    // the rest fits into 64 bits. The digits of a chunk don't depend on the
+    // next wide division, so the two can overlap.
+    T wide = number;
+    uint64_t n;
+    while (!Traits::toUint64(wide, n)) {
+        uint64_t chunk = Traits::divide(wide, _chunkDivider);
+        for (size_t i = 0; i < _chunkDigits; i++) {
+            const uint64_t quotient = _digitDivider.divide(chunk);
+            *--first = alphabet[chunk - quotient * _digitDivider.divisor()];
+            chunk = quotient;
+        }
+    }
+
+    do {
+        const uint64_t quotient = _digitDivider.divide(n);
+        *--first = alphabet[n - quotient * _digitDivider.divisor()];
+        n = quotient;
+    } while (n > 0);
+
+    const size_t length = static_cast<size_t>(end - first);
+    if (length > capacity) {
+        return 0;
+    }
+
+    std::memcpy(out, first, length);
+
+    return length;
+}
+
+///
+/// The number of digits toId() writes for a number.
+///
+template<typename T>
+size_t Sqids<T>::digitCount(const T& number) const
+{
+    // Wide numbers are split into chunks like toId() does; every chunk but
+    // the most significant one is written with all its digits
+    size_t digits = 0;
+    T wide = number;
+    uint64_t n;
+    while (!Traits::toUint64(wide, n)) {
+        Traits::divide(wide, _chunkDivider);
+        digits += _chunkDigits;
+    }
+
+    // Compare with increasing powers of the base until one is larger, or
+    // the next one doesn't fit into 64 bits
+    const uint64_t base = _digitDivider.divisor();
+    digits++;
+    for (uint64_t power = base; n >= power; power *= base) {
+        digits++;
+        if (power > UINT64_MAX / base) {
+            break;
+        }
+    }
+
+    return digits;
+}
+
+///
+/// The length of an ID holding `count` numbers of `digits` digits in total:
+/// the `prefix`, the numbers and a `separator` between each of them, padded
+/// to `minLength`.
+///
+template<typename T>
+size_t Sqids<T>::idLength(size_t count, size_t digits) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    return std::max<size_t>(1 + digits + (count - 1), _minLength);
+}
+
+///
+/// Convert an ID back into a number. The digits are looked up in
+/// `positions`, the positions of the characters in an alphabet whose first
+/// character (the `separator`) isn't used for digits.
+///
+template<typename T>
+T Sqids<T>::toNumber(std::string_view id, const uint8_t* positions, size_t alphabetSize) const
+{
+    T a = 0;
+
+    for (unsigned char ch : id) {
+        Traits::multiplyAdd(a, alphabetSize, positions[_alphabetIndex[ch]] - 1);
+    }
+
+    return a;
+}
+
+///
+/// @overload
+///
+/// Takes the positions of the ID's characters in the original alphabet,
+/// instead of the characters themselves.
+///
+template<typename T>
+T Sqids<T>::toNumber(const uint8_t* indices, size_t length, const uint8_t* positions, size_t alphabetSize) const
+{
+    T a = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        Traits::multiplyAdd(a, alphabetSize, positions[indices[i]] - 1);
+    }
+
+    return a;
+}
+
+template<typename T>
+inline bool Sqids<T>::isBlockedId(const char* id, size_t length) const
+{
+    return _blocklist->matches(id, length);
+}
+
+template<typename T>
+Sqids<T>::Encoder::Encoder(const Sqids<T>* _sqids, const T* _numbers, size_t _count, char* _out, size_t _capacity)
+  : sqids(_sqids),
+    numbers(_numbers),
+    count(_count),
+    out(_out),
+    capacity(_capacity),
+    length(0)
+{
+}
+
+template<typename T>
+Result<size_t> Sqids<T>::Encoder::run()
+{
+    const size_t alphabetSize = sqids->_alphabet.size();
+
+    // Get a semi-random offset from input numbers. Only the increment added
+    // to it changes between attempts, so it's computed once.
+    auto a = count;
+
+    for (unsigned int i = 0; i < count; i++) {
+        a += i + sqids->_alphabet[Traits::remainder(numbers[i], sqids->_alphabetDivider)];
+    }
+
+    size_t offset = sqids->_alphabetDivider.remainder(a);
+
+    for (unsigned int increment = 0; increment <= alphabetSize; increment++) {
+        if (!generate(offset)) {
+            return Error::BufferTooSmall;
+        }
+
+#if defined(SQIDS_INSTRUMENTATION)
+        const auto checkStart = std::chrono::steady_clock::now();
+        const bool blocked = sqids->isBlockedId(out, length);
+        blocklistTime += std::chrono::steady_clock::now() - checkStart;
+#else
+        const bool blocked = sqids->isBlockedId(out, length);
+#endif
+
+        if (!blocked) {
+            SQIDS_INSTRUMENT(encoded(count, increment, blocklistTime));
+            return length;
+        }
+
+        // if ID has a blocked word anywhere, try again with a +1 increment,
+        // overwriting the blocked ID
+        offset = (offset + 1 == alphabetSize) ? 0 : offset + 1;
+    }
+
+    SQIDS_INSTRUMENT(encodeFailed(count, static_cast<unsigned int>(alphabetSize), blocklistTime));
+    return Error::MaxAttempts;
+}
+
+///
+/// Write the ID for `offset` into the output buffer, without checking it
+/// against the blocklist.
+///
+/// @return `false` if the buffer is too small for the ID
+///
+template<typename T>
+bool Sqids<T>::Encoder::generate(size_t offset)
+{
+    const size_t alphabetSize = sqids->_alphabet.size();
 
-	// The first character of the alphabet is going to be reserved for the `separator`
-	const auto alphabetWithoutSeparator = alphabet.substr(1);
+    // Re-arrange alphabet so that second-half goes in front of the first-half,
+    // and reverse it
+    WorkingAlphabet alphabet(sqids, offset, false);
+
+    // The final ID will always have the `prefix` character at the beginning.
+    // It's the first character of the re-arranged alphabet, used for
+    // randomization
+    length = 0;
+    if (!append(&sqids->_alphabet[offset], 1)) {
+        return false;
+    }
 
-	id += sqids->toId(*it, alphabetWithoutSeparator);
+    // Encode the input array
+    for (size_t i = 0; i < count; i++) {
+        // The first character of the alphabet is going to be reserved for the `separator`
+        const size_t digits = sqids->toId(numbers[i], alphabet.chars + 1, out + length, capacity - length);
+        if (digits == 0) {
+            return false;
+        }
+        length += digits;
 
         // If not the last number
-        if (std::next(it) != numbers.cend()) {
+        if (i + 1 < count) {
             // `separator` character is used to isolate numbers within the ID
-            id.push_back(alphabet[0]);
+            if (!append(alphabet.chars, 1)) {
+                return false;
+            }
 
-	    // Shuffle on every iteration
-	    sqids->shuffle(alphabet);
+            // Shuffle on every iteration
+            alphabet.shuffle();
         }
     }
 
     // Handle `minLength` requirement, if the ID is too short
-    if (sqids->_minLength > id.size()) {
+    if (sqids->_minLength > length) {
         // Append a separator
-        id.push_back(alphabet[0]);
+        if (!append(alphabet.chars, 1)) {
+            return false;
+        }
 
         // For decoding: two separators next to each other is what tells us the
         // rest are junk characters
-        while (sqids->_minLength - id.size() > 0) {
-	    sqids->shuffle(alphabet);
-            id += alphabet.substr(0, std::min(sqids->_minLength - id.size(), alphabet.size()));
+        while (sqids->_minLength - length > 0) {
+            alphabet.shuffle();
+            if (!append(alphabet.chars, std::min(sqids->_minLength - length, alphabetSize))) {
+                return false;
+            }
         }
     }
 
-    // if ID has a blocked word anywhere, restart with a +1 increment
-    if (sqids->isBlockedId(id)) {
-        return run(increment + 1);
+    return true;
+}
+
+template<typename T>
+inline bool Sqids<T>::Encoder::append(const char* chars, size_t n)
+{
+    if (capacity - length < n) {
+        return false;
     }
 
-    return id;
+    std::memcpy(out + length, chars, n);
+    length += n;
+
+    return true;
+}
+
+///
+/// @param sqids  The instance decoding the ID
+/// @param id     The ID to decode
+///
+template<typename T>
+Sqids<T>::LazyDecoder::LazyDecoder(const Sqids<T>* sqids, std::string_view id)
+  : _sqids(sqids),
+    _id(id),
+    _error(Error::None),
+    _alphabet(sqids, validate(sqids, id, _error), true),
+    _start(_error == Error::None ? 1 : id.size()),
+    _shufflePending(false),
+    _count(0)
+{
+}
+
+template<typename T>
+Sqids<T>::LazyDecoder::~LazyDecoder()
+{
+    if (_error == Error::None) {
+        reportDecode(_count);
+    }
+}
+
+///
+/// Read the next integer of the ID.
+///
+/// @param number  Receives the integer
+/// @return        Whether there was one; `false` once the integers, or the
+///                ID, have ended
+///
+template<typename T>
+bool Sqids<T>::LazyDecoder::next(T& number)
+{
+    if (_start >= _id.size()) {
+        return false;
+    }
+
+    // The alphabet is only shuffled once the next integer is read, just as
+    // the encoding function shuffles it after every integer
+    if (_shufflePending) {
+        _alphabet.shuffle();
+        _shufflePending = false;
+    }
+
+    size_t end = _id.find(_alphabet.chars[0], _start);
+    const bool hasSeparator = (end != std::string_view::npos);
+    if (!hasSeparator) {
+        end = _id.size();
+    }
+
+    // Two separators next to each other mean the rest are junk characters
+    if (end == _start) {
+        _start = _id.size();
+        return false;
+    }
+
+    number = _sqids->toNumber(_id.substr(_start, end - _start), _alphabet.positions, _sqids->_alphabet.size() - 1);
+
+    _start = hasSeparator ? end + 1 : _id.size();
+    _shufflePending = hasSeparator;
+    _count++;
+
+    return true;
+}
+
+///
+/// Check an ID like decode() does.
+///
+/// @return The offset of the alphabet the ID starts with, or 0 if the ID is
+///         rejected, in which case `error` tells why
+///
+template<typename T>
+size_t Sqids<T>::LazyDecoder::validate(const Sqids<T>* sqids, std::string_view id, Error& error)
+{
+    if (id.empty()) {
+        error = Error::EmptyId;
+        reportDecode(error);
+        return 0;
+    }
+
+    const auto offset = sqids->_alphabetIndex[static_cast<unsigned char>(id[0])];
+    if (offset == NOT_IN_ALPHABET || !sqids->_alphabetLookup.validate(id.data(), id.size())) {
+        error = Error::InvalidCharacter;
+        reportDecode(error);
+        return 0;
+    }
+
+    return offset;
+}
+
+template<typename T>
+Sqids<T>::WorkingAlphabet::WorkingAlphabet(const Sqids<T>* _sqids, size_t offset, bool _trackPositions)
+  : sqids(_sqids),
+    trackPositions(_trackPositions),
+    generation(0)
+{
+    const size_t alphabetSize = sqids->_alphabet.size();
+
+    if (sqids->_alphabetCacheDepth > 0) {
+        const size_t start = offset * sqids->_alphabetCacheDepth * alphabetSize;
+        chars = &sqids->_alphabetCache[start];
+        positions = &sqids->_positionCache[start];
+        return;
+    }
+
+    // Computed ahead of time, and left as soon as the alphabet is shuffled
+    if (sqids->_rotations) {
+        chars = sqids->_rotations + offset * alphabetSize;
+        positions = sqids->_rotationPositions + offset * alphabetSize;
+        return;
+    }
+
+    // Re-arrange alphabet so that second-half goes in front of the first-half,
+    // and reverse it. Reversed, the first-half comes first.
+    const auto first = sqids->_alphabet.cbegin();
+    std::reverse_copy(first, first + offset, localChars);
+    std::reverse_copy(first + offset, sqids->_alphabet.cend(), localChars + offset);
+
+    if (trackPositions) {
+        for (size_t i = 0; i < alphabetSize; i++) {
+            localPositions[sqids->_alphabetIndex[static_cast<unsigned char>(localChars[i])]] = static_cast<uint8_t>(i);
+        }
+    }
+
+    chars = localChars;
+    positions = localPositions;
+}
+
+///
+/// Move on to the next generation of the alphabet.
+///
+template<typename T>
+void Sqids<T>::WorkingAlphabet::shuffle()
+{
+    const size_t alphabetSize = sqids->_alphabet.size();
+
+    generation++;
+
+    // Still inside the cache, the next generation is right after this one
+    if (generation < sqids->_alphabetCacheDepth) {
+        chars += alphabetSize;
+        positions += alphabetSize;
+        return;
+    }
+
+    // Leaving the cache, continue with a copy of the last generation
+    if (chars != localChars) {
+        std::copy(chars, chars + alphabetSize, localChars);
+        std::copy(positions, positions + alphabetSize, localPositions);
+        chars = localChars;
+        positions = localPositions;
+    }
+
+    if (trackPositions) {
+        sqids->shuffle(localChars, alphabetSize, localPositions);
+    } else {
+        sqids->shuffle(localChars, alphabetSize);
+    }
 }
 
 } // namespace sqidscxx
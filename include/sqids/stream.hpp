@@ -0,0 +1,222 @@
+///
+/// @file stream.hpp
+///
+/// Decoding of IDs from large inputs, such as log exports or CSV files,
+/// which are read in chunks or memory-mapped.
+///
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sqids.hpp"
+
+namespace sqidscxx
+{
+///
+/// @class StreamDecoder
+///
+/// @brief Splits a stream of bytes into records and decodes the ID found in
+///        each of them, without allocating memory per record.
+///
+/// Records are separated by `delimiter`; a carriage return before the
+/// delimiter is ignored. If a field separator is given, the ID is taken from
+/// field `column` of each record (fields aren't quoted). Records without that
+/// field decode as an empty sequence.
+///
+/// Chunks can end anywhere, including in the middle of a record. The decoder
+/// keeps the incomplete record until the rest of it arrives. Its buffers grow
+/// to the size of the longest record and are reused after that.
+///
+/// Typical use:
+///
+/// @code
+/// sqidscxx::StreamDecoder<> decoder(sqids, '\n', ',', 2);
+/// auto print = [](std::string_view id, const uint64_t* numbers, size_t count) { ... };
+///
+/// while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+///     decoder.feed(buffer, length, print);
+/// }
+/// decoder.finish(print);
+/// @endcode
+///
+template<typename T = uint64_t>
+class StreamDecoder
+{
+public:
+    static constexpr char NO_SEPARATOR = '\0';
+
+    explicit StreamDecoder(const Sqids<T>& sqids, char delimiter = '\n', char separator = NO_SEPARATOR,
+                           size_t column = 0);
+
+    template<typename Callback>
+    size_t feed(const char* data, size_t length, Callback&& callback);
+
+    template<typename Callback>
+    size_t finish(Callback&& callback);
+
+private:
+    std::string_view field(std::string_view record) const;
+
+    template<typename Callback>
+    void decodeRecord(std::string_view record, Callback& callback);
+
+    const Sqids<T>& _sqids;
+    const char _delimiter;
+    const char _separator;
+    const size_t _column;
+
+    // The start of a record that continues in the next chunk
+    std::string _pending;
+
+    // Receives the numbers of each ID
+    std::vector<T> _numbers;
+};
+
+///
+/// @param sqids      The instance to decode with. It must outlive the decoder.
+/// @param delimiter  The character that ends every record
+/// @param separator  The character that separates fields, or `NO_SEPARATOR`
+///                   if every record is a single ID
+/// @param column     The field holding the ID, counting from 0
+///
+template<typename T>
+StreamDecoder<T>::StreamDecoder(const Sqids<T>& sqids, char delimiter, char separator, size_t column)
+  : _sqids(sqids),
+    _delimiter(delimiter),
+    _separator(separator),
+    _column(column),
+    _numbers(16)
+{
+}
+
+///
+/// Decode all records completed by the next chunk of input.
+///
+/// @param data      The chunk
+/// @param length    The length of the chunk
+/// @param callback  Called as `callback(id, numbers, count)` for every record,
+///                  in order. `id` and `numbers` are only valid during the
+///                  call. Invalid IDs are passed with a `count` of 0.
+/// @return          The number of records decoded
+///
+template<typename T>
+template<typename Callback>
+size_t StreamDecoder<T>::feed(const char* data, size_t length, Callback&& callback)
+{
+    const char* const end = data + length;
+    size_t records = 0;
+
+    while (data < end) {
+        const char* next = static_cast<const char*>(std::memchr(data, _delimiter, end - data));
+        if (next == nullptr) {
+            _pending.append(data, end);
+            break;
+        }
+
+        if (_pending.empty()) {
+            decodeRecord(std::string_view(data, next - data), callback);
+        } else {
+            _pending.append(data, next);
+            decodeRecord(_pending, callback);
+            _pending.clear();
+        }
+
+        records++;
+        data = next + 1;
+    }
+
+    return records;
+}
+
+///
+/// Decode the last record, if the input didn't end with a delimiter.
+///
+/// @return The number of records decoded, 0 or 1
+///
+template<typename T>
+template<typename Callback>
+size_t StreamDecoder<T>::finish(Callback&& callback)
+{
+    if (_pending.empty()) {
+        return 0;
+    }
+
+    decodeRecord(_pending, callback);
+    _pending.clear();
+
+    return 1;
+}
+
+template<typename T>
+std::string_view StreamDecoder<T>::field(std::string_view record) const
+{
+    if (!record.empty() && record.back() == '\r') {
+        record.remove_suffix(1);
+    }
+
+    if (_separator == NO_SEPARATOR) {
+        return record;
+    }
+
+    for (size_t i = 0; i < _column; i++) {
+        const size_t separator = record.find(_separator);
+        if (separator == std::string_view::npos) {
+            return std::string_view();
+        }
+        record.remove_prefix(separator + 1);
+    }
+
+    return record.substr(0, record.find(_separator));
+}
+
+template<typename T>
+template<typename Callback>
+void StreamDecoder<T>::decodeRecord(std::string_view record, Callback& callback)
+{
+    const std::string_view id = field(record);
+
+    // Every integer but the last takes at least two characters, including its
+    // `separator`, so the buffer is grown to fit before decoding rather than
+    // decoding again
+    if (_numbers.size() < id.size() / 2) {
+        _numbers.resize(id.size() / 2);
+    }
+
+    const size_t count = _sqids.decodeInto(id, _numbers.data(), _numbers.size());
+
+    callback(id, static_cast<const T*>(_numbers.data()), count);
+}
+
+///
+/// Decode every record of a buffer, such as a memory-mapped file, into a
+/// batch: record `i` becomes `out.data(i)` and `out.count(i)`.
+///
+/// @param sqids      The instance to decode with
+/// @param data       The buffer
+/// @param length     The length of the buffer
+/// @param out        Receives the decoded integers
+/// @param delimiter  The character that ends every record
+/// @param separator  The character that separates fields, or
+///                   `StreamDecoder<T>::NO_SEPARATOR`
+/// @param column     The field holding the ID, counting from 0
+///
+template<typename T>
+void decodeStream(const Sqids<T>& sqids, const char* data, size_t length, DecodedBatch<T>& out,
+                  char delimiter = '\n', char separator = StreamDecoder<T>::NO_SEPARATOR, size_t column = 0)
+{
+    out.numbers.clear();
+    out.offsets.assign(1, 0);
+
+    auto append = [&out](std::string_view, const T* numbers, size_t count) {
+        out.numbers.insert(out.numbers.end(), numbers, numbers + count);
+        out.offsets.push_back(out.numbers.size());
+    };
+
+    StreamDecoder<T> decoder(sqids, delimiter, separator, column);
+    decoder.feed(data, length, append);
+    decoder.finish(append);
+}
+
+} // namespace sqidscxx
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sqids/sqids.hpp>
+
+// Counts the allocations made through it, and the bytes they request
+template<typename V>
+struct CountingAllocator
+{
+    using value_type = V;
+
+    explicit CountingAllocator(size_t* _allocations, size_t* _bytes = nullptr)
+      : allocations(_allocations), bytes(_bytes) {}
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : allocations(other.allocations), bytes(other.bytes) {}
+
+    V* allocate(size_t n)
+    {
+        ++*allocations;
+        if (bytes) {
+            *bytes += n * sizeof(V);
+        }
+        return std::allocator<V>().allocate(n);
+    }
+
+    void deallocate(V* p, size_t n) { std::allocator<V>().deallocate(p, n); }
+
+    size_t* allocations;
+    size_t* bytes;
+};
+
+template<typename V, typename U>
+bool operator==(const CountingAllocator<V>& a, const CountingAllocator<U>& b) {
+    return a.allocations == b.allocations;
+}
+
+template<typename V, typename U>
+bool operator!=(const CountingAllocator<V>& a, const CountingAllocator<U>& b) {
+    return !(a == b);
+}
+
+TEST(Allocators, EncodeAndDecodeAllocateOnce) {
+    sqidscxx::Sqids<> sqids({ minLength: 40 });
+
+    // Enough numbers to make the ID longer than the stack buffers
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 40; i++) {
+        numbers.push_back(i * 2654435761u);
+    }
+
+    for (const size_t count : { size_t(1), size_t(3), numbers.size() }) {
+        size_t allocations = 0;
+
+        const auto id = sqids.encode(numbers.data(), count, CountingAllocator<char>(&allocations));
+        EXPECT_EQ(std::string_view(id), sqids.encode(std::vector<uint64_t>(numbers.begin(), numbers.begin() + count)));
+        EXPECT_EQ(allocations, 1u);
+
+        allocations = 0;
+        const auto decoded = sqids.decode(id, CountingAllocator<uint64_t>(&allocations));
+        EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), numbers.begin(), numbers.begin() + count));
+        EXPECT_EQ(allocations, 1u);
+    }
+
+    size_t allocations = 0;
+    EXPECT_TRUE(sqids.decode("*", CountingAllocator<uint64_t>(&allocations)).empty());
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(Allocators, EncodeAllocatesExactLength) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 40; i++) {
+        numbers.push_back(i);
+    }
+
+    // Far shorter than the longest ID 40 integers could encode into
+    size_t allocations = 0;
+    size_t bytes = 0;
+    const auto id = sqids.encode(numbers.data(), numbers.size(), CountingAllocator<char>(&allocations, &bytes));
+    ASSERT_GT(sqids.maxEncodedLength(numbers.size()), 256u);
+    EXPECT_EQ(std::string_view(id), sqids.encode(numbers));
+    EXPECT_EQ(allocations, 1u);
+    EXPECT_LE(bytes, id.size() + 1);
+}
+
+TEST(Allocators, CanonicalDecodingOfLongIdsAllocatesOnce) {
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 40; i++) {
+        numbers.push_back(i * 2654435761u);
+    }
+
+    // The first attempt is blocked, so the ID with the same numbers is not canonical
+    const auto blocked = sqidscxx::Sqids<>({ blocklist: {} }).encode(numbers);
+    ASSERT_GT(blocked.size(), 256u);
+
+    std::string word(blocked.substr(0, 5));
+    std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+    sqidscxx::Sqids<> sqids({ blocklist: { word }, canonicalDecoding: true });
+
+    const auto id = sqids.encode(numbers);
+    ASSERT_NE(id, blocked);
+
+    // Checking the regenerated ID needs no memory beyond the result
+    size_t allocations = 0;
+    const auto decoded = sqids.decode(id, CountingAllocator<uint64_t>(&allocations));
+    EXPECT_EQ(std::vector<uint64_t>(decoded.begin(), decoded.end()), numbers);
+    EXPECT_EQ(allocations, 1u);
+
+    allocations = 0;
+    EXPECT_TRUE(sqids.decode(blocked, CountingAllocator<uint64_t>(&allocations)).empty());
+    EXPECT_EQ(allocations, 0u);
+}
+
+#if SQIDS_PMR
+TEST(Allocators, EncodeAndDecodeFromAnArena) {
+    sqidscxx::Sqids<> sqids({ minLength: 10 });
+
+    // Any allocation that doesn't come from the arena fails
+    char storage[4096];
+    std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+
+    const uint64_t numbers[] = { 1, 2, 3 };
+    const std::pmr::string id = sqids.encode(numbers, 3, &arena);
+    EXPECT_EQ(id, "86Rf07xd4z");
+
+    const std::pmr::vector<uint64_t> decoded = sqids.decode(id, &arena);
+    EXPECT_EQ(std::vector<uint64_t>(decoded.begin(), decoded.end()), sqids.numbers({ 1, 2, 3 }));
+
+    std::pmr::string reused(&arena);
+    sqids.encodeInto(numbers, 3, reused);
+    EXPECT_EQ(reused, id);
+}
+
+TEST(Allocators, CanonicalDecodingFromAnArena) {
+    const auto numbers = sqidscxx::Sqids<>().numbers({ 4572721 });
+    sqidscxx::Sqids<> sqids({ blocklist: { "aho1e" }, canonicalDecoding: true });
+
+    char storage[1024];
+    std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+
+    // The regenerated ID is verified by generating the blocked attempt again
+    const auto id = sqids.encode(numbers.data(), numbers.size(), &arena);
+    EXPECT_EQ(sqids.decode(id, &arena).at(0), 4572721u);
+    EXPECT_TRUE(sqids.decode("aho1e", &arena).empty());
+}
+#endif
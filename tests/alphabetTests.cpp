@@ -38,3 +38,129 @@ TEST(AlphabetTest, RepeatingAlphabetCharacters) {
 TEST(AlphabetTest, TooShortOfAnAlphabet) {
     ASSERT_THROW(sqidscxx::Sqids<>({ alphabet: "ab" }), std::runtime_error);
 }
+
+TEST(AlphabetTest, BulkLookupMatchesTable) {
+    const std::string alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+    std::array<uint8_t, 256> index;
+    index.fill(sqidscxx::AlphabetLookup::NOT_IN_ALPHABET);
+    for (size_t i = 0; i < alphabet.size(); i++) {
+        index[static_cast<unsigned char>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+
+    const sqidscxx::AlphabetLookup lookup(index);
+
+    for (size_t length = 0; length < 100; length++) {
+        std::string input;
+        for (size_t i = 0; i < length; i++) {
+            input.push_back(alphabet[(i * 7 + length) % alphabet.size()]);
+        }
+
+        std::vector<uint8_t> positions(length);
+        ASSERT_TRUE(lookup.validate(input.data(), input.size()));
+        ASSERT_TRUE(lookup.map(input.data(), input.size(), positions.data()));
+        for (size_t i = 0; i < length; i++) {
+            EXPECT_EQ(positions[i], index[static_cast<unsigned char>(input[i])]);
+        }
+
+        // Every invalid character must be caught, wherever it is
+        for (size_t i = 0; i < length; i++) {
+            for (char invalid : { '*', '\0', '\x80', '\xff' }) {
+                std::string corrupted(input);
+                corrupted[i] = invalid;
+                EXPECT_FALSE(lookup.validate(corrupted.data(), corrupted.size()));
+                EXPECT_FALSE(lookup.map(corrupted.data(), corrupted.size(), positions.data()));
+            }
+        }
+    }
+}
+
+TEST(AlphabetTest, DecodeRejectsInvalidCharactersInLongIds) {
+    sqidscxx::Sqids<> sqids({ minLength: 200 });
+
+    const auto numbers(sqids.numbers({ 1, 2, 3 }));
+    const auto id = sqids.encode(numbers);
+
+    EXPECT_EQ(sqids.decode(id), numbers);
+    EXPECT_EQ(sqids.decode(id + id), numbers);
+
+    for (size_t i : { size_t(0), size_t(1), size_t(17), size_t(199), id.size() + 150 }) {
+        std::string corrupted(id + id);
+        corrupted[i] = '-';
+        EXPECT_EQ(sqids.decode(corrupted), sqids.numbers({}));
+    }
+}
+
+TEST(AlphabetTest, DecodeFromEveryOffset) {
+    const sqidscxx::Sqids<> sqids;
+    const sqidscxx::Sqids<> cached({ alphabetCacheDepth: 3 });
+
+    // Round trips through most re-arrangements of the alphabet, and a few
+    // generations of each
+    for (uint64_t i = 0; i < 62; i++) {
+        for (uint64_t j = 0; j < 62; j++) {
+            const auto numbers(sqids.numbers({ i, j, 0, UINT64_MAX }));
+            const auto id = sqids.encode(numbers);
+
+            EXPECT_EQ(sqids.decode(id), numbers);
+            EXPECT_EQ(cached.decode(id), numbers);
+        }
+    }
+
+    // An ID can start with any character of the alphabet. Its positions are
+    // looked up in a re-arrangement built on the fly, or taken from the cache,
+    // which must agree.
+    const auto body = sqids.encode({ 1, 2, 3, 4 }).substr(1);
+    for (char prefix : sqidscxx::SqidsOptions().alphabet) {
+        EXPECT_EQ(cached.decode(prefix + body), sqids.decode(prefix + body));
+    }
+}
+
+TEST(AlphabetTest, DecodeLongIdsCharacterByCharacter) {
+    sqidscxx::Sqids<> sqids;
+
+    // Too long to be mapped in bulk
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 40; i++) {
+        numbers.push_back(UINT64_MAX / (i + 1));
+    }
+    const auto id = sqids.encode(numbers);
+
+    ASSERT_GT(id.size(), 256u);
+    EXPECT_EQ(sqids.decode(id), numbers);
+}
+
+TEST(AlphabetTest, DecodeRejectsCharactersOutsideTheAlphabet) {
+    sqidscxx::Sqids<> sqids({ alphabet: "0123456789abcdef" });
+
+    const auto numbers(sqids.numbers({ 1, 2, 3 }));
+    const auto id = sqids.encode(numbers);
+
+    // Bytes next to the alphabet's, outside of ASCII, and null
+    for (char invalid : { '/', ':', '`', 'g', 'A', '\0', '\x7f', '\x80', '\xff' }) {
+        for (size_t i = 0; i < id.size(); i++) {
+            std::string corrupted(id);
+            corrupted[i] = invalid;
+            EXPECT_EQ(sqids.decode(corrupted), sqids.numbers({}));
+            EXPECT_EQ(sqids.tryDecode(corrupted).error(), sqidscxx::Error::InvalidCharacter);
+        }
+
+        EXPECT_EQ(sqids.decode(id + invalid), sqids.numbers({}));
+    }
+}
+
+TEST(AlphabetTest, AlphabetAtTheEdgesOfTheTable) {
+    // The first and last characters an alphabet can have
+    sqidscxx::Sqids<> sqids({ alphabet: std::string("\0\x01\x02\x7d\x7e\x7f", 6), blocklist: {} });
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        const auto numbers(sqids.numbers({ i, i * 31 }));
+        EXPECT_EQ(sqids.decode(sqids.encode(numbers)), numbers);
+    }
+
+    const auto id = sqids.encode({ 1, 2, 3 });
+    for (char invalid : { '\x03', '\x7c', '\x80', '\xff' }) {
+        EXPECT_EQ(sqids.decode(id + invalid), sqids.numbers({}));
+        EXPECT_EQ(sqids.decode(invalid + id), sqids.numbers({}));
+    }
+}
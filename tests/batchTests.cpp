@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <sqids/sqids.hpp>
+
+TEST(Batch, EncodeSingleNumbers) {
+    sqidscxx::Sqids<> sqids;
+
+    const auto numbers(sqids.numbers({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    sqidscxx::EncodedBatch ids;
+    sqids.encodeBatch(numbers.data(), numbers.size(), 1, ids);
+
+    ASSERT_EQ(ids.size(), numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++) {
+        EXPECT_EQ(ids[i], sqids.encode({ numbers[i] }));
+    }
+}
+
+TEST(Batch, EncodeAndDecodePairs) {
+    sqidscxx::Sqids<> sqids({ minLength: 8 });
+
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 1000; i++) {
+        numbers.push_back(i / 10);
+        numbers.push_back(i * 7919);
+    }
+
+    sqidscxx::EncodedBatch ids;
+    sqids.encodeBatch(numbers.data(), numbers.size() / 2, 2, ids);
+
+    ASSERT_EQ(ids.size(), numbers.size() / 2);
+    for (size_t i = 0; i < ids.size(); i++) {
+        EXPECT_EQ(ids[i], sqids.encode({ numbers[2 * i], numbers[2 * i + 1] }));
+    }
+
+    sqidscxx::DecodedBatch<uint64_t> decoded;
+    sqids.decodeBatch(ids, decoded);
+
+    ASSERT_EQ(decoded.size(), ids.size());
+    EXPECT_EQ(decoded.numbers, numbers);
+    for (size_t i = 0; i < decoded.size(); i++) {
+        EXPECT_EQ(decoded.count(i), 2u);
+    }
+}
+
+TEST(Batch, DecodeInvalidIds) {
+    sqidscxx::Sqids<> sqids;
+
+    const std::string_view ids[] = { "86Rf07", "", "*", "bM" };
+
+    sqidscxx::DecodedBatch<uint64_t> decoded;
+    sqids.decodeBatch(ids, 4, decoded);
+
+    ASSERT_EQ(decoded.size(), 4u);
+    EXPECT_EQ(decoded.count(0), 3u);
+    EXPECT_EQ(decoded.count(1), 0u);
+    EXPECT_EQ(decoded.count(2), 0u);
+    EXPECT_EQ(decoded.count(3), 1u);
+    EXPECT_EQ(decoded.numbers, sqids.numbers({ 1, 2, 3, 0 }));
+}
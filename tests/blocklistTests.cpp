@@ -1,3 +1,10 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <sqids/sqids.hpp>
 
@@ -107,3 +114,277 @@ TEST(Blocklist, MaxEncodingAttempts) {
 
     ASSERT_THROW(sqids.encode({ 0 }), std::runtime_error);
 }
+
+TEST(Blocklist, MatcherAgreesWithWordByWordScan) {
+    // Reference implementation: check every word against the ID
+    const auto isBlocked = [](const std::string& id, const std::set<std::string>& words) {
+        std::string lowercaseId(id);
+        std::transform(lowercaseId.begin(), lowercaseId.end(), lowercaseId.begin(), ::tolower);
+
+        for (const auto& word : words) {
+            if (word.size() > id.size()) {
+                continue;
+            }
+            if (id.size() <= 3 || word.size() <= 3) {
+                if (lowercaseId == word) {
+                    return true;
+                }
+            } else if (std::any_of(word.cbegin(), word.cend(), ::isdigit)) {
+                if (lowercaseId.find(word) == 0 || lowercaseId.rfind(word) == id.size() - word.size()) {
+                    return true;
+                }
+            } else if (lowercaseId.find(word) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const std::set<std::string> words(sqidscxx::defaultBlocklist());
+    const sqidscxx::BlocklistMatcher matcher(words);
+    const std::string alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+    std::vector<std::string> ids;
+    for (const auto& word : words) {
+        ids.push_back(word);
+        ids.push_back("x" + word);
+        ids.push_back(word + "X");
+        ids.push_back("Xy" + word + "z");
+        ids.push_back(word.substr(1));
+    }
+
+    uint32_t state = 12345;
+    for (int i = 0; i < 20000; i++) {
+        std::string id;
+        const size_t length = 1 + i % 12;
+        for (size_t j = 0; j < length; j++) {
+            state = state * 1103515245 + 12345;
+            id.push_back(alphabet[(state >> 16) % alphabet.size()]);
+        }
+        ids.push_back(id);
+    }
+
+    for (const auto& id : ids) {
+        EXPECT_EQ(matcher.matches(id), isBlocked(id, words)) << id;
+
+        // IDs read in pieces are checked the same way
+        sqidscxx::BlocklistMatcher::Scanner scanner(matcher);
+        for (size_t start = 0; start < id.size(); start += 2) {
+            scanner.feed(id.data() + start, std::min<size_t>(2, id.size() - start));
+        }
+        EXPECT_EQ(scanner.finish(), matcher.matches(id)) << id;
+    }
+}
+
+TEST(Blocklist, MatcherSupportsEveryByte) {
+    // Words using all 256 byte values, which need more character classes than
+    // a byte can count unless uppercase letters share them
+    std::vector<std::string> words;
+    for (unsigned int ch = 0; ch < 256; ch += 4) {
+        words.push_back({ char(ch), char(ch + 1), char(ch + 2), char(ch + 3) });
+    }
+    const sqidscxx::BlocklistMatcher matcher(words);
+
+    for (const auto& word : words) {
+        EXPECT_TRUE(matcher.matches(word + "x"));
+    }
+    EXPECT_FALSE(matcher.matches(std::string("\xFF\xFE\xFD\xFC")));
+    EXPECT_FALSE(matcher.matches(std::string("\x00\x01\x02\x04", 4)));
+
+    // Every class is stored in the image
+    const std::string image = matcher.serialize();
+    const auto data = std::make_shared<std::vector<uint32_t>>(image.size() / 4);
+    std::memcpy(data->data(), image.data(), image.size());
+    EXPECT_TRUE(sqidscxx::BlocklistMatcher::fromImage(data, data->data(), image.size())->matches(words[42] + "x"));
+}
+
+TEST(Blocklist, DefaultIsCopiedOnWrite) {
+    sqidscxx::Blocklist blocklist = sqidscxx::Blocklist::defaults();
+    EXPECT_TRUE(blocklist.isDefault());
+    EXPECT_EQ(blocklist.size(), sqidscxx::DEFAULT_BLOCKLIST_WORDS.size());
+
+    blocklist.insert("pnd");
+    EXPECT_FALSE(blocklist.isDefault());
+    EXPECT_EQ(blocklist.size(), sqidscxx::DEFAULT_BLOCKLIST_WORDS.size() + 1);
+    EXPECT_EQ(sqidscxx::defaultBlocklist().count("pnd"), 0u);
+
+    blocklist.clear();
+    EXPECT_TRUE(blocklist.empty());
+    EXPECT_TRUE(sqidscxx::Blocklist({}).empty());
+}
+
+TEST(Blocklist, UsableAsASet) {
+    const auto size = [](const std::set<std::string>& words) {
+        return words.size();
+    };
+
+    // What compiled when SqidsOptions::blocklist and DEFAULT_BLOCKLIST were sets
+    sqidscxx::SqidsOptions options;
+    options.blocklist = sqidscxx::DEFAULT_BLOCKLIST;
+    EXPECT_TRUE(options.blocklist.isDefault());
+    EXPECT_EQ(size(sqidscxx::DEFAULT_BLOCKLIST), sqidscxx::DEFAULT_BLOCKLIST_WORDS.size());
+
+    EXPECT_TRUE(options.blocklist.insert("pnd").second);
+    EXPECT_FALSE(options.blocklist.insert("pnd").second);
+    EXPECT_EQ(*options.blocklist.find("pnd"), "pnd");
+    EXPECT_EQ(options.blocklist.erase("pnd"), 1u);
+    EXPECT_EQ(options.blocklist.erase("pnd"), 0u);
+
+    std::set<std::string> words = { "abc", "cab" };
+    options.blocklist = words;
+    options.blocklist.insert(words.begin(), words.end());
+    EXPECT_EQ(size(options.blocklist), 2u);
+
+    words = options.blocklist;
+    EXPECT_EQ(words, std::set<std::string>({ "abc", "cab" }));
+}
+
+TEST(Blocklist, DefaultMatcherIsShared) {
+    const sqidscxx::Blocklist blocklist = sqidscxx::Blocklist::defaults();
+
+    // Only the characters of the alphabet matter, not their order or case
+    const auto matcher = blocklist.compile("abcdefghijklmnopqrstuvwxyz0123456789");
+    EXPECT_EQ(blocklist.compile("0123456789ZYXWVUTSRQPONMLKJIHGFEDCBA"), matcher);
+    EXPECT_NE(blocklist.compile("abcdefghijklmnopqrstuvwxyz"), matcher);
+}
+
+TEST(Blocklist, DefaultMatcherOutlivesInstances) {
+    std::weak_ptr<const sqidscxx::BlocklistMatcher> matcher;
+    {
+        const sqidscxx::Sqids<> sqids({ alphabet: "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ" });
+        matcher = sqidscxx::Blocklist::defaults().compile("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    }
+
+    // No instance uses the default matcher any more, but it isn't compiled again
+    ASSERT_FALSE(matcher.expired());
+    EXPECT_EQ(sqidscxx::Blocklist::defaults().compile("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"),
+              matcher.lock());
+}
+
+TEST(Blocklist, CustomMatcherIsShared) {
+    const sqidscxx::Blocklist custom = { "cab", "abc", "bca" };
+
+    // Blocklists with the same words share their matcher, and words with
+    // characters that aren't in the alphabet don't matter
+    const auto matcher = custom.compile("abcdefghijklmnopqrstuvwxyz0123456789");
+    EXPECT_EQ(custom.compile("0123456789ZYXWVUTSRQPONMLKJIHGFEDCBA"), matcher);
+    EXPECT_EQ(sqidscxx::Blocklist({ "bca", "cab", "ABC", "ab" }).compile("abcdefghijklmnopqrstuvwxyz0123456789"), matcher);
+    EXPECT_EQ(sqidscxx::Blocklist({ "cab", "abc", "bca", "ab*" }).compile("abcdefghijklmnopqrstuvwxyz0123456789"), matcher);
+
+    EXPECT_NE(sqidscxx::Blocklist({ "cab", "abc" }).compile("abcdefghijklmnopqrstuvwxyz0123456789"), matcher);
+    EXPECT_NE(custom.compile("abcdefghijklmnopqrstuvwxyz"), matcher);
+    EXPECT_NE(sqidscxx::Blocklist::defaults().compile("abcdefghijklmnopqrstuvwxyz0123456789"), matcher);
+}
+
+TEST(Blocklist, UnusedMatchersAreCompiledAgain) {
+    // Enough blocklists to have the cache swept a few times
+    for (int i = 0; i < 100; i++) {
+        const std::string word = "abc" + std::to_string(i);
+        const auto matcher = sqidscxx::Blocklist({ word }).compile("abcdefghijklmnopqrstuvwxyz0123456789");
+
+        EXPECT_TRUE(matcher->matches("x" + word));
+        EXPECT_EQ(sqidscxx::Blocklist({ word }).compile("abcdefghijklmnopqrstuvwxyz0123456789"), matcher);
+    }
+
+    const auto matcher = sqidscxx::Blocklist({ "abc7" }).compile("abcdefghijklmnopqrstuvwxyz0123456789");
+    EXPECT_TRUE(matcher->matches("abc7"));
+    EXPECT_FALSE(matcher->matches("abc8"));
+}
+
+TEST(Blocklist, SharedMatcherGivesSameIds) {
+    const sqidscxx::Sqids<> first;
+    const sqidscxx::Sqids<> second({ alphabet: "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz" });
+    const sqidscxx::Sqids<> third;
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        EXPECT_EQ(first.encode({ i, i * 7 }), third.encode({ i, i * 7 }));
+        EXPECT_EQ(second.decode(second.encode({ i })), std::vector<uint64_t>({ i }));
+    }
+}
+
+TEST(Blocklist, SerializedMatcherMatchesLikeTheOriginal) {
+    const auto original = sqidscxx::Blocklist::defaults().compile(sqidscxx::SqidsOptions().alphabet);
+    const std::string image = original->serialize();
+
+    const std::string path = ::testing::TempDir() + "sqids_blocklist.bin";
+    std::ofstream(path, std::ios::binary).write(image.data(), image.size());
+
+    const auto loaded = sqidscxx::BlocklistMatcher::load(path);
+    EXPECT_EQ(loaded->serialize(), image);
+
+    for (const char* id : { "aho1e", "AHO1E", "xaho1ex", "0rgasm", "x0rgasmx", "sexy", "xXSexYx", "86Rf07", "abc" }) {
+        EXPECT_EQ(loaded->matches(id), original->matches(id)) << id;
+    }
+
+    const sqidscxx::Sqids<> sqids;
+    const sqidscxx::Sqids<> precompiled({ blocklist: sqidscxx::Blocklist::load(path) });
+    for (uint64_t i = 0; i < 1000; i++) {
+        EXPECT_EQ(precompiled.encode({ i, 4572721 }), sqids.encode({ i, 4572721 }));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(Blocklist, InvalidImagesAreRejected) {
+    const std::string image = sqidscxx::Blocklist({ "cab", "abc" }).compile("abc")->serialize();
+    const auto data = std::make_shared<std::vector<uint32_t>>(image.size() / 4);
+    std::memcpy(data->data(), image.data(), image.size());
+
+    EXPECT_NO_THROW(sqidscxx::BlocklistMatcher::fromImage(data, data->data(), image.size()));
+    EXPECT_THROW(sqidscxx::BlocklistMatcher::fromImage(data, data->data(), image.size() - 1), std::runtime_error);
+
+    (*data)[0] ^= 1;
+    EXPECT_THROW(sqidscxx::BlocklistMatcher::fromImage(data, data->data(), image.size()), std::runtime_error);
+
+    EXPECT_THROW(sqidscxx::BlocklistMatcher::load(::testing::TempDir() + "sqids_missing.bin"), std::runtime_error);
+}
+
+TEST(Blocklist, DamagedImagesAreRejected) {
+    const std::string image = sqidscxx::Blocklist({ "cab", "abc", "bca1" }).compile("abc1")->serialize();
+
+    // Change one 4-byte word, or one byte, of a valid image
+    const auto damaged = [&image](size_t offset, uint32_t value, size_t width) {
+        const auto data = std::make_shared<std::vector<uint32_t>>(image.size() / 4 + 1);
+        std::memcpy(data->data(), image.data(), image.size());
+        std::memcpy(reinterpret_cast<char*>(data->data()) + offset, &value, width);
+        return sqidscxx::BlocklistMatcher::fromImage(data, data->data(), image.size());
+    };
+
+    // The header is 16 words, followed by the root transitions, failure links,
+    // edge offsets and edge targets, then the 256 character classes
+    uint32_t counts[3];
+    std::memcpy(counts, image.data() + 16, sizeof(counts));
+    const uint32_t classCount = counts[0];
+    const uint32_t nodeCount = counts[1];
+    const uint32_t edgeCount = counts[2];
+
+    const size_t rootTransitions = 64;
+    const size_t failureLinks = rootTransitions + 4 * classCount;
+    const size_t edgeOffsets = failureLinks + 4 * nodeCount;
+    const size_t edgeTargets = edgeOffsets + 4 * (nodeCount + 1);
+    const size_t classes = edgeTargets + 4 * edgeCount;
+
+    EXPECT_NO_THROW(damaged(rootTransitions, 0, 4));
+
+    EXPECT_THROW(damaged(rootTransitions + 4, nodeCount, 4), std::runtime_error);
+    EXPECT_THROW(damaged(failureLinks + 4, UINT32_MAX, 4), std::runtime_error);
+    EXPECT_THROW(damaged(failureLinks + 4, 1, 4), std::runtime_error);
+    EXPECT_THROW(damaged(edgeOffsets + 4, edgeCount + 1, 4), std::runtime_error);
+    EXPECT_THROW(damaged(edgeOffsets + 4 * nodeCount, edgeCount - 1, 4), std::runtime_error);
+    EXPECT_THROW(damaged(edgeTargets, nodeCount, 4), std::runtime_error);
+    EXPECT_THROW(damaged(edgeTargets + 4, 0, 4), std::runtime_error);
+    EXPECT_THROW(damaged(classes + 'a', classCount, 1), std::runtime_error);
+}
+
+TEST(Blocklist, PrecompiledBlocklistChecksTheAlphabet) {
+    sqidscxx::Blocklist blocklist =
+        sqidscxx::Blocklist::precompiled(sqidscxx::Blocklist::defaults().compile("abcdefghijklmnopqrstuvwxyz"));
+
+    EXPECT_NO_THROW(blocklist.compile("ABCxyz"));
+    EXPECT_THROW(blocklist.compile("abc012"), std::runtime_error);
+    EXPECT_THROW(blocklist.insert("pnd"), std::runtime_error);
+
+    blocklist.clear();
+    EXPECT_TRUE(blocklist.empty());
+    EXPECT_EQ(blocklist.matcher(), nullptr);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <sqids/cache.hpp>
+#include <thread>
+
+TEST(Cache, ReturnsTheSameResults) {
+    const sqidscxx::Sqids<> sqids({ minLength: 8 });
+    sqidscxx::CachedSqids<> cached(sqids, 1024);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint64_t i = 0; i < 32; i++) {
+            const auto numbers = sqids.numbers({ i, i * 1000 });
+            const auto id = sqids.encode(numbers);
+
+            EXPECT_EQ(cached.encode(numbers), id);
+            EXPECT_EQ(cached.decode(id), numbers);
+        }
+    }
+
+    const auto statistics = cached.statistics();
+    EXPECT_EQ(statistics.encodeMisses, 32u);
+    EXPECT_EQ(statistics.encodeHits, 32u);
+    EXPECT_EQ(statistics.decodeMisses, 32u);
+    EXPECT_EQ(statistics.decodeHits, 32u);
+    EXPECT_EQ(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.size, 64u);
+    EXPECT_DOUBLE_EQ(statistics.hitRate(), 0.5);
+}
+
+TEST(Cache, EvictsUnreferencedEntries) {
+    const sqidscxx::Sqids<> sqids;
+    sqidscxx::CachedSqids<> cached(sqids, 4, 1);
+
+    const auto hot = sqids.numbers({ 42 });
+    cached.encode(hot);
+
+    for (uint64_t i = 0; i < 100; i++) {
+        // The hot entry is referenced again before the hand comes back to it
+        EXPECT_EQ(cached.encode(hot), sqids.encode(hot));
+        cached.encode({ 1000 + i });
+    }
+
+    const auto statistics = cached.statistics();
+    EXPECT_EQ(statistics.encodeHits, 100u);
+    EXPECT_EQ(statistics.encodeMisses, 101u);
+    EXPECT_EQ(statistics.evictions, 97u);
+    EXPECT_EQ(statistics.size, 4u);
+}
+
+TEST(Cache, DoesNotCacheFailures) {
+    const sqidscxx::Sqids<int> sqids;
+    sqidscxx::CachedSqids<int> cached(sqids, 16);
+
+    EXPECT_THROW(cached.encode({ -1 }), std::runtime_error);
+    EXPECT_THROW(cached.encode({ -1 }), std::runtime_error);
+    EXPECT_EQ(cached.decode("*"), sqids.numbers({}));
+    EXPECT_EQ(cached.decode(""), sqids.numbers({}));
+
+    EXPECT_EQ(cached.statistics().size, 0u);
+}
+
+TEST(Cache, ZeroCapacityPassesThrough) {
+    const sqidscxx::Sqids<> sqids;
+    sqidscxx::CachedSqids<> cached(sqids, 0);
+
+    EXPECT_EQ(cached.encode({ 1, 2, 3 }), "86Rf07");
+    EXPECT_EQ(cached.decode("86Rf07"), sqids.numbers({ 1, 2, 3 }));
+
+    const auto statistics = cached.statistics();
+    EXPECT_EQ(statistics.encodeMisses + statistics.decodeMisses, 0u);
+    EXPECT_EQ(statistics.size, 0u);
+}
+
+TEST(Cache, ClearKeepsCounters) {
+    const sqidscxx::Sqids<> sqids;
+    sqidscxx::CachedSqids<> cached(sqids, 16);
+
+    cached.encode({ 1 });
+    cached.encode({ 1 });
+    cached.clear();
+    cached.encode({ 1 });
+
+    const auto statistics = cached.statistics();
+    EXPECT_EQ(statistics.encodeHits, 1u);
+    EXPECT_EQ(statistics.encodeMisses, 2u);
+    EXPECT_EQ(statistics.size, 1u);
+}
+
+TEST(Cache, IsThreadSafe) {
+    const sqidscxx::Sqids<> sqids;
+    sqidscxx::CachedSqids<> cached(sqids, 64, 4);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            for (uint64_t i = 0; i < 2000; i++) {
+                const auto numbers = sqids.numbers({ (i * 7 + t) % 100 });
+                const auto id = cached.encode(numbers);
+                if (id != sqids.encode(numbers) || cached.decode(id) != numbers) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures, std::vector<int>(4, 0));
+
+    const auto statistics = cached.statistics();
+    EXPECT_EQ(statistics.encodeHits + statistics.encodeMisses, 8000u);
+    EXPECT_LE(statistics.size, 128u);
+}
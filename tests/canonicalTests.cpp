@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sqids/sqids.hpp>
+
+// Check every ID of up to `maxLength` characters: canonical decoding
+// accepts exactly the IDs that encode() generates for their numbers
+static void expectCanonical(const sqidscxx::SqidsOptions& options, size_t maxLength) {
+    sqidscxx::SqidsOptions canonicalOptions = options;
+    canonicalOptions.canonicalDecoding = true;
+
+    sqidscxx::Sqids<uint8_t> sqids(options);
+    sqidscxx::Sqids<uint8_t> canonical(canonicalOptions);
+
+    size_t accepted = 0;
+    std::string id;
+    for (size_t length = 1; length <= maxLength; length++) {
+        std::vector<size_t> digits(length, 0);
+        id.assign(length, options.alphabet[0]);
+
+        while (true) {
+            const auto numbers = sqids.decode(id);
+            const auto expected = sqids.tryEncode(numbers);
+            const bool isCanonical = !numbers.empty() && expected && *expected == id;
+
+            const auto decoded = canonical.tryDecode(id);
+            EXPECT_EQ(decoded.has_value(), isCanonical) << id;
+            if (isCanonical) {
+                EXPECT_EQ(*decoded, numbers) << id;
+                accepted++;
+            } else if (!numbers.empty()) {
+                EXPECT_EQ(decoded.error(), sqidscxx::Error::NonCanonical) << id;
+            }
+
+            // Next ID
+            size_t i = 0;
+            while (i < length && ++digits[i] == options.alphabet.size()) {
+                digits[i] = 0;
+                id[i] = options.alphabet[0];
+                i++;
+            }
+            if (i == length) {
+                break;
+            }
+            id[i] = options.alphabet[digits[i]];
+        }
+    }
+
+    EXPECT_GT(accepted, 0u);
+}
+
+TEST(Canonical, AcceptsExactlyEncodedIds) {
+    expectCanonical({ alphabet: "abcdefgh", minLength: 0, blocklist: {} }, 5);
+}
+
+TEST(Canonical, AcceptsExactlyEncodedIdsWithMinLength) {
+    expectCanonical({ alphabet: "abcdefgh", minLength: 4, blocklist: {} }, 5);
+    expectCanonical({ alphabet: "abc", minLength: 7, blocklist: {} }, 8);
+}
+
+TEST(Canonical, AcceptsExactlyEncodedIdsWithBlocklist) {
+    expectCanonical({ alphabet: "abcdefgh", minLength: 0, blocklist: { "gah", "ebb", "adcb", "hdah" } }, 5);
+    expectCanonical({ alphabet: "abcdefgh", minLength: 3, blocklist: { "fgc", "ecc", "bcf", "dhe" } }, 5);
+}
+
+TEST(Canonical, RejectsPaddedIds) {
+    sqidscxx::Sqids<> padded({ minLength: 10 });
+    sqidscxx::Sqids<> sqids({ canonicalDecoding: true });
+    sqidscxx::Sqids<> canonicalPadded({ minLength: 10, canonicalDecoding: true });
+
+    const auto numbers = sqids.numbers({ 1, 2, 3 });
+    ASSERT_EQ(padded.encode(numbers), "86Rf07xd4z");
+
+    EXPECT_EQ(sqids.decode("86Rf07"), numbers);
+    EXPECT_EQ(sqids.decode("86Rf07xd4z"), sqids.numbers({}));
+    EXPECT_EQ(sqids.tryDecode("86Rf07xd4z").error(), sqidscxx::Error::NonCanonical);
+
+    EXPECT_EQ(canonicalPadded.decode("86Rf07xd4z"), numbers);
+    EXPECT_EQ(canonicalPadded.decode("86Rf07"), sqids.numbers({}));
+    EXPECT_EQ(canonicalPadded.decode("86Rf07xd4a"), sqids.numbers({}));
+    EXPECT_EQ(canonicalPadded.decode("86Rf07xd4zz"), sqids.numbers({}));
+}
+
+TEST(Canonical, RejectsBlockedIds) {
+    sqidscxx::Sqids<> unblocked({ blocklist: {} });
+    const auto numbers = unblocked.numbers({ 4572721 });
+    ASSERT_EQ(unblocked.encode(numbers), "aho1e");
+
+    sqidscxx::Sqids<> sqids({ blocklist: { "aho1e" }, canonicalDecoding: true });
+    const auto id = sqids.encode(numbers);
+    ASSERT_NE(id, "aho1e");
+
+    EXPECT_EQ(sqids.decode(id), numbers);
+    EXPECT_EQ(sqids.decode("aho1e"), sqids.numbers({}));
+}
+
+TEST(Canonical, RejectsLongBlockedIds) {
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 40; i++) {
+        numbers.push_back(i * 2654435761u);
+    }
+
+    sqidscxx::Sqids<> unblocked({ blocklist: {} });
+    const auto blocked = unblocked.encode(numbers);
+    ASSERT_GT(blocked.size(), 256u);
+
+    // Block the first two attempts, so the ID is generated at the third
+    std::string word(blocked.substr(0, 5));
+    std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+    sqidscxx::Sqids<> once({ blocklist: { word } });
+    std::string second(once.encode(numbers).substr(0, 5));
+    std::transform(second.begin(), second.end(), second.begin(), ::tolower);
+
+    sqidscxx::Sqids<> sqids({ blocklist: { word, second }, canonicalDecoding: true });
+    const auto id = sqids.encode(numbers);
+    ASSERT_NE(id, blocked);
+    ASSERT_NE(id, once.encode(numbers));
+
+    uint64_t decoded[64];
+    const auto count = sqids.tryDecodeInto(id, decoded, 64);
+    ASSERT_TRUE(count);
+    EXPECT_EQ(std::vector<uint64_t>(decoded, decoded + *count), numbers);
+
+    EXPECT_EQ(sqids.tryDecodeInto(blocked, decoded, 64).error(), sqidscxx::Error::NonCanonical);
+    EXPECT_EQ(sqids.tryDecodeInto(once.encode(numbers), decoded, 64).error(), sqidscxx::Error::NonCanonical);
+}
+
+TEST(Canonical, DecodeBatchDropsRejectedIds) {
+    sqidscxx::Sqids<> sqids({ canonicalDecoding: true });
+
+    const std::string_view ids[] = { "86Rf07", "86Rf07xd4z", "bM" };
+
+    sqidscxx::DecodedBatch<uint64_t> decoded;
+    sqids.decodeBatch(ids, 3, decoded);
+
+    ASSERT_EQ(decoded.size(), 3u);
+    EXPECT_EQ(decoded.count(0), 3u);
+    EXPECT_EQ(decoded.count(1), 0u);
+    EXPECT_EQ(decoded.count(2), 1u);
+    EXPECT_EQ(decoded.numbers, sqids.numbers({ 1, 2, 3, 0 }));
+}
+
+TEST(Canonical, DecodeAcceptsNonCanonicalIdsByDefault) {
+    sqidscxx::Sqids<> sqids;
+
+    EXPECT_EQ(sqids.decode("86Rf07xd4z"), sqids.numbers({ 1, 2, 3 }));
+}
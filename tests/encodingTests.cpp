@@ -136,3 +136,264 @@ TEST(Decoding, EncodeOutOfRangeNumbers) {
     ASSERT_THROW(sqids.encode({ -1 }), std::runtime_error);
     ASSERT_THROW(sqids.encode({ static_cast<int16_t>(sqids.maxValue + 1) }), std::runtime_error);
 }
+
+TEST(Encoding, EncodeToBuffer) {
+    sqidscxx::Sqids<> sqids({ minLength: 10 });
+
+    const auto numbers(sqids.numbers({ 1, 2, 3 }));
+
+    char buffer[64];
+    const size_t length = sqids.encodeTo(numbers.data(), numbers.size(), buffer, sizeof(buffer));
+
+    EXPECT_EQ(std::string(buffer, length), "86Rf07xd4z");
+    EXPECT_EQ(std::string(buffer, length), sqids.encode(numbers));
+
+    ASSERT_THROW(sqids.encodeTo(numbers.data(), numbers.size(), buffer, 9), std::length_error);
+}
+
+TEST(Encoding, EncodeIntoReusesString) {
+    sqidscxx::Sqids<> sqids;
+
+    std::string id;
+    sqids.encodeInto(sqids.numbers({ 1, 2, 3 }), id);
+    EXPECT_EQ(id, "86Rf07");
+
+    sqids.encodeInto(sqids.numbers({ 0 }), id);
+    EXPECT_EQ(id, "bM");
+}
+
+TEST(Encoding, MaxEncodedLength) {
+    sqidscxx::Sqids<> sqids;
+
+    const auto numbers(sqids.numbers({ sqids.maxValue, sqids.maxValue, sqids.maxValue }));
+
+    EXPECT_EQ(sqids.maxEncodedLength(0), 0u);
+    EXPECT_EQ(sqids.encode(numbers).size(), sqids.maxEncodedLength(numbers.size()));
+    EXPECT_EQ(sqidscxx::Sqids<>({ minLength: 100 }).maxEncodedLength(1), 100u);
+}
+
+TEST(Encoding, EncodedLength) {
+    sqidscxx::Sqids<> sqids;
+    sqidscxx::Sqids<> padded({ minLength: 10 });
+    sqidscxx::Sqids<> binary({ alphabet: "abc" });
+
+    // Every power of two, and the numbers on either side of it
+    std::vector<uint64_t> numbers = { 0 };
+    for (int bit = 0; bit < 64; bit++) {
+        numbers.push_back((uint64_t(1) << bit) - 1);
+        numbers.push_back(uint64_t(1) << bit);
+        numbers.push_back((uint64_t(1) << bit) + 1);
+    }
+
+    for (const auto number : numbers) {
+        for (const auto* instance : { &sqids, &padded, &binary }) {
+            EXPECT_EQ(instance->encodedLength({ number }), instance->encode({ number }).size()) << number;
+            EXPECT_EQ(instance->encodedLength({ number, 7, number }), instance->encode({ number, 7, number }).size())
+                << number;
+        }
+    }
+
+    EXPECT_EQ(sqids.encodedLength({}), 0u);
+    EXPECT_EQ(padded.encodedLength({ 1, 2, 3 }), 10u);
+    EXPECT_THROW(sqidscxx::Sqids<int>().encodedLength({ -1 }), std::runtime_error);
+}
+
+TEST(Encoding, EncodedLengthOfRegeneratedIds) {
+    const auto numbers = sqidscxx::Sqids<>().numbers({ 4572721 });
+    sqidscxx::Sqids<> sqids({ blocklist: { "aho1e" } });
+
+    EXPECT_EQ(sqids.encodedLength(numbers), sqids.encode(numbers).size());
+}
+
+TEST(Encoding, MaxEncodedLengthOfRange) {
+    sqidscxx::Sqids<> sqids;
+
+    // Every number up to the maximum fits into its maximum length
+    for (const uint64_t max : { 0ull, 60ull, 61ull, 1000000ull, 1ull << 40 }) {
+        EXPECT_EQ(sqids.maxEncodedLength(2, max), sqids.encode({ max, max }).size()) << max;
+        EXPECT_LE(sqids.encodedLength({ max / 2, max / 3 }), sqids.maxEncodedLength(2, max)) << max;
+    }
+
+    EXPECT_EQ(sqids.maxEncodedLength(3, sqids.maxValue), sqids.maxEncodedLength(3));
+    EXPECT_EQ(sqidscxx::Sqids<>({ minLength: 32 }).maxEncodedLength(2, 1000), 32u);
+    EXPECT_THROW(sqidscxx::Sqids<int>().maxEncodedLength(1, -1), std::runtime_error);
+}
+
+TEST(Decoding, DecodeIntoArray) {
+    sqidscxx::Sqids<> sqids({ minLength: 20 });
+
+    const auto numbers(sqids.numbers({ 1, 2, 3, 4 }));
+    const auto id = sqids.encode(numbers);
+
+    uint64_t output[4];
+    ASSERT_EQ(sqids.decodeInto(id, output, 4), 4u);
+    EXPECT_EQ(std::vector<uint64_t>(output, output + 4), numbers);
+
+    // Only as many numbers as fit are written, but all of them are counted
+    uint64_t partial[2] = { 0, 0 };
+    ASSERT_EQ(sqids.decodeInto(id, partial, 2), 4u);
+    EXPECT_EQ(partial[0], 1u);
+    EXPECT_EQ(partial[1], 2u);
+
+    EXPECT_EQ(sqids.decodeInto("", output, 4), 0u);
+    EXPECT_EQ(sqids.decodeInto("*", output, 4), 0u);
+}
+
+TEST(Encoding, AlphabetCache) {
+    sqidscxx::Sqids<> sqids;
+
+    const size_t alphabetSize = sqidscxx::SqidsOptions().alphabet.size();
+
+    for (uint8_t depth : { 1, 2, 5 }) {
+        sqidscxx::SqidsOptions options;
+        options.minLength = 30;
+        options.alphabetCacheDepth = depth;
+        sqidscxx::Sqids<> cached(options);
+
+        options.alphabetCacheDepth = 0;
+        sqidscxx::Sqids<> uncached(options);
+
+        EXPECT_EQ(cached.alphabetCacheBytes(), 2 * depth * alphabetSize * alphabetSize);
+        EXPECT_EQ(uncached.alphabetCacheBytes(), 0u);
+
+        for (const auto& numbers : { sqids.numbers({ 0 }), sqids.numbers({ 1, 2, 3 }),
+                                     sqids.numbers({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }) }) {
+            const auto id = cached.encode(numbers);
+
+            EXPECT_EQ(id, uncached.encode(numbers));
+            EXPECT_EQ(cached.decode(id), numbers);
+        }
+    }
+}
+
+TEST(Encoding, DividerMatchesDivision) {
+    std::vector<uint64_t> values = { 0, 1, 2, 60, 61, 62, 127, 128, UINT32_MAX, UINT64_MAX - 1, UINT64_MAX };
+
+    uint64_t state = 1;
+    for (int i = 0; i < 1000; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values.push_back(state >> (i % 64));
+    }
+
+    for (uint64_t divisor = 2; divisor <= 128; divisor++) {
+        const sqidscxx::Divider divider(divisor);
+
+        for (auto n : values) {
+            ASSERT_EQ(divider.divide(n), n / divisor) << n << " / " << divisor;
+            ASSERT_EQ(divider.remainder(n), n % divisor) << n << " % " << divisor;
+        }
+    }
+}
+
+TEST(Encoding, EncodeFixedArity) {
+    sqidscxx::Sqids<> sqids;
+
+    EXPECT_EQ(sqids.encode(std::array<uint64_t, 3> { 1, 2, 3 }), "86Rf07");
+    EXPECT_EQ(sqids.encode(std::array<uint64_t, 0> {}), "");
+    EXPECT_EQ(sqids.encode(std::make_tuple(uint32_t(1), uint64_t(2), 3u)), "86Rf07");
+
+    const uint64_t max = sqids.maxValue;
+    EXPECT_EQ(sqids.encode(std::array<uint64_t, 2> { max, max }), sqids.encode({ max, max }));
+
+    sqidscxx::Sqids<> padded({ minLength: 255 });
+    EXPECT_EQ(padded.encode(std::array<uint64_t, 1> { 1 }), padded.encode({ 1 }));
+}
+
+#if SQIDS_SPAN
+TEST(Encoding, EncodeSpan) {
+    sqidscxx::Sqids<> sqids;
+
+    uint64_t numbers[] = { 1, 2, 3 };
+    EXPECT_EQ(sqids.encode(std::span<const uint64_t>(numbers)), "86Rf07");
+    EXPECT_EQ(sqids.encode(std::span<uint64_t, 3>(numbers)), "86Rf07");
+    EXPECT_EQ(sqids.encode(std::span<uint64_t>(numbers).first(0)), "");
+
+    // Braced lists still go to the std::vector overload
+    EXPECT_EQ(sqids.encode({}), "");
+    EXPECT_EQ(sqids.encode({ 1, 2, 3 }), "86Rf07");
+}
+#endif
+
+TEST(Decoding, DecodeFixedArity) {
+    sqidscxx::Sqids<> sqids;
+
+    const auto numbers = sqids.decode<3>("86Rf07");
+    ASSERT_TRUE(numbers.has_value());
+    EXPECT_EQ(*numbers, (std::array<uint64_t, 3> { 1, 2, 3 }));
+
+    EXPECT_FALSE(sqids.decode<2>("86Rf07").has_value());
+    EXPECT_FALSE(sqids.decode<4>("86Rf07").has_value());
+    EXPECT_FALSE(sqids.decode<1>("*").has_value());
+    EXPECT_TRUE(sqids.decode<0>("").has_value());
+}
+
+TEST(Decoding, DecodeLazily) {
+    for (const uint8_t minLength : { 0, 10, 255 }) {
+        for (const uint8_t depth : { 0, 2 }) {
+            sqidscxx::Sqids<> sqids({ minLength: minLength, alphabetCacheDepth: depth });
+
+            const auto numbers = sqids.numbers({ 7, 0, 123456789, sqids.maxValue, 42 });
+            const auto id = sqids.encode(numbers);
+
+            std::vector<uint64_t> decoded;
+            for (const auto number : sqids.decodeLazily(id)) {
+                decoded.push_back(number);
+            }
+            EXPECT_EQ(decoded, numbers);
+
+            for (size_t count = 0; count <= numbers.size() + 1; count++) {
+                const auto prefix = sqids.decodePrefix(id, count);
+                EXPECT_EQ(prefix, std::vector<uint64_t>(numbers.begin(), numbers.begin() + std::min(count, numbers.size())));
+            }
+
+            EXPECT_EQ(sqids.decodeFirst(id), std::optional<uint64_t>(7));
+        }
+    }
+}
+
+TEST(Decoding, DecodePrefixMatchesDecode) {
+    sqidscxx::Sqids<uint8_t> sqids({ alphabet: "abcdef" });
+
+    // Every ID of up to 5 characters, valid or not
+    for (size_t length = 1, total = 6; length <= 5; length++, total *= 6) {
+        for (size_t n = 0; n < total; n++) {
+            std::string id;
+            for (size_t i = 0, rest = n; i < length; i++, rest /= 6) {
+                id += "abcdef"[rest % 6];
+            }
+
+            const auto numbers = sqids.decode(id);
+            for (size_t count = 0; count <= 3; count++) {
+                EXPECT_EQ(sqids.decodePrefix(id, count),
+                          std::vector<uint8_t>(numbers.begin(), numbers.begin() + std::min(count, numbers.size())))
+                    << id;
+            }
+        }
+    }
+}
+
+TEST(Decoding, DecodeLazilyRejectsInvalidIds) {
+    sqidscxx::Sqids<> sqids;
+
+    auto empty = sqids.decodeLazily("");
+    uint64_t number;
+    EXPECT_FALSE(empty.next(number));
+    EXPECT_EQ(empty.error(), sqidscxx::Error::EmptyId);
+
+    // Invalid characters after the first integer are found too
+    auto invalid = sqids.decodeLazily("86Rf07*");
+    EXPECT_FALSE(invalid.next(number));
+    EXPECT_EQ(invalid.error(), sqidscxx::Error::InvalidCharacter);
+
+    EXPECT_EQ(sqids.decodeFirst("86Rf07*"), std::nullopt);
+    EXPECT_EQ(sqids.decodePrefix("*", 2), sqids.numbers({}));
+    EXPECT_EQ(sqids.decodeLazily("86Rf07").error(), sqidscxx::Error::None);
+}
+
+TEST(Decoding, DecodeFirstWithCanonicalDecoding) {
+    sqidscxx::Sqids<> sqids({ canonicalDecoding: true });
+
+    EXPECT_EQ(sqids.decodeFirst("86Rf07"), std::optional<uint64_t>(1));
+    EXPECT_EQ(sqids.decodePrefix("86Rf07", 2), sqids.numbers({ 1, 2 }));
+    EXPECT_EQ(sqids.decodeFirst("86Rf07xd4z"), std::nullopt);
+}
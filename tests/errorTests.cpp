@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <sqids/sqids.hpp>
+
+TEST(Errors, TryEncodeMatchesEncode) {
+    sqidscxx::Sqids<> sqids({ minLength: 10 });
+
+    const auto numbers = sqids.numbers({ 1, 2, 3 });
+    const auto id = sqids.tryEncode(numbers);
+
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(*id, "86Rf07xd4z");
+    EXPECT_EQ(sqids.tryEncode({}).value(), "");
+
+    char buffer[10];
+    const auto length = sqids.tryEncodeTo(numbers.data(), numbers.size(), buffer, sizeof(buffer));
+    ASSERT_TRUE(length);
+    EXPECT_EQ(std::string(buffer, *length), "86Rf07xd4z");
+}
+
+TEST(Errors, TryEncodeReportsErrors) {
+    sqidscxx::Sqids<int16_t> sqids;
+
+    EXPECT_EQ(sqids.tryEncode({ 1, -1 }).error(), sqidscxx::Error::OutOfRange);
+
+    char buffer[64];
+    const int16_t numbers[] = { 1, 2, 3 };
+    EXPECT_EQ(sqids.tryEncodeTo(numbers, 3, buffer, 5).error(), sqidscxx::Error::BufferTooSmall);
+    EXPECT_EQ(sqids.tryEncodeTo(numbers, 3, buffer, 0).error(), sqidscxx::Error::BufferTooSmall);
+    EXPECT_EQ(sqids.tryEncodeTo(numbers, 3, buffer, 6).value(), 6u);
+
+    // Block every ID this alphabet can generate for the number
+    sqidscxx::Sqids<> blocked({ alphabet: "abc", minLength: 3, blocklist: { "cab", "abc", "bca" } });
+    EXPECT_EQ(blocked.tryEncode({ 0 }).error(), sqidscxx::Error::MaxAttempts);
+}
+
+TEST(Errors, TryEncodeReportsErrorsForLongIds) {
+    sqidscxx::Sqids<int16_t> sqids;
+
+    // Too many numbers for the IDs to be generated on the stack
+    std::vector<int16_t> numbers(100, 1);
+    ASSERT_GT(sqids.maxEncodedLength(numbers.size()), 256u);
+    EXPECT_EQ(sqids.tryEncode(numbers).value(), sqids.encode(numbers));
+
+    numbers.back() = -1;
+    EXPECT_EQ(sqids.tryEncode(numbers).error(), sqidscxx::Error::OutOfRange);
+
+    // Every ID longer than 3 characters holds one of these words
+    std::set<std::string> words = { "" };
+    for (int length = 0; length < 4; length++) {
+        std::set<std::string> longer;
+        for (const auto& word : words) {
+            for (const char ch : { 'a', 'b', 'c' }) {
+                longer.insert(word + ch);
+            }
+        }
+        words.swap(longer);
+    }
+    sqidscxx::Sqids<> blocked({ alphabet: "abc", blocklist: words });
+
+    const std::vector<uint64_t> large(8, UINT64_MAX);
+    ASSERT_GT(blocked.encodedLength(large), 256u);
+    EXPECT_EQ(blocked.tryEncode(large).error(), sqidscxx::Error::MaxAttempts);
+}
+
+TEST(Errors, TryDecodeTellsFailuresApart) {
+    sqidscxx::Sqids<> sqids;
+
+    EXPECT_EQ(sqids.tryDecode("86Rf07").value(), sqids.numbers({ 1, 2, 3 }));
+    EXPECT_EQ(sqids.tryDecode("").error(), sqidscxx::Error::EmptyId);
+    EXPECT_EQ(sqids.tryDecode("86Rf*7").error(), sqidscxx::Error::InvalidCharacter);
+
+    uint64_t numbers[2];
+    EXPECT_EQ(sqids.tryDecodeInto("86Rf07", numbers, 2).value(), 3u);
+    EXPECT_EQ(sqids.tryDecodeInto("*", numbers, 2).error(), sqidscxx::Error::InvalidCharacter);
+    EXPECT_EQ(sqids.tryDecodeInto("*", numbers, 2).value_or(0), 0u);
+}
+
+#if SQIDS_EXCEPTIONS
+TEST(Errors, ThrowingApiIsUnchanged) {
+    sqidscxx::Sqids<int16_t> sqids;
+
+    EXPECT_THROW(sqids.encode({ -1 }), std::runtime_error);
+    EXPECT_THROW(sqids.tryEncode({ -1 }).value(), std::runtime_error);
+
+    char buffer[5];
+    const int16_t numbers[] = { 1, 2, 3 };
+    EXPECT_THROW(sqids.encodeTo(numbers, 3, buffer, sizeof(buffer)), std::length_error);
+}
+#endif
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <sqids/fixed.hpp>
+
+struct Base36
+{
+    static constexpr std::string_view value = "0123456789abcdefghijklmnopqrstuvwxyz";
+};
+
+struct Abc
+{
+    static constexpr std::string_view value = "abc";
+};
+
+TEST(Fixed, AlphabetIsShuffledAtCompileTime) {
+    static_assert(sqidscxx::FixedSqids<Abc>::alphabet().size() == 3);
+    static_assert(sqidscxx::FixedAlphabet<Abc>::index['a'] < 3);
+    static_assert(sqidscxx::FixedAlphabet<Abc>::index['d'] == sqidscxx::AlphabetLookup::NOT_IN_ALPHABET);
+
+    EXPECT_EQ(sqidscxx::FixedSqids<sqidscxx::DefaultAlphabet>::alphabet(),
+              "fwjBhEY2uczNPDiloxmvISCrytaJO4d71T0W3qnMZbXVHg6eR8sAQ5KkpLUGF9");
+}
+
+TEST(Fixed, TablesAreComputedAtCompileTime) {
+    using Tables = sqidscxx::FixedAlphabet<Base36>;
+
+    // Offset 0 is the whole alphabet reversed; offset 1 starts with the first
+    // character, followed by the others reversed
+    static_assert(Tables::rotations[0] == Tables::chars[35]);
+    static_assert(Tables::rotations[36] == Tables::chars[0]);
+    static_assert(Tables::rotations[37] == Tables::chars[35]);
+    static_assert(Tables::positions[36 + Tables::index[static_cast<unsigned char>(Tables::chars[35])]] == 1);
+
+    static_assert(Tables::tables.alphabetDivider.divisor() == 36);
+    static_assert(Tables::tables.digitDivider.divisor() == 35);
+    static_assert(Tables::tables.chunkDivider.divisor() == 35ull * 35 * 35 * 35 * 35 * 35);
+    static_assert(Tables::tables.chunkDigits == 6);
+
+    // The default blocklist is looked up once, and the alphabets need no cache
+    const sqidscxx::FixedSqids<Base36> first;
+    const sqidscxx::FixedSqids<Base36> second;
+    EXPECT_EQ(first.blocklistMatcher(), second.blocklistMatcher());
+    EXPECT_EQ(first.alphabetCacheBytes(), 0u);
+}
+
+TEST(Fixed, MatchesDefaultInstance) {
+    const sqidscxx::FixedSqids<sqidscxx::DefaultAlphabet> fixed;
+    const sqidscxx::Sqids<> sqids;
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        const auto numbers = sqids.numbers({ i, i * 31, 0 });
+        EXPECT_EQ(fixed.encode(numbers), sqids.encode(numbers));
+        EXPECT_EQ(fixed.decode(sqids.encode(numbers)), numbers);
+    }
+}
+
+TEST(Fixed, MatchesInstanceWithOptions) {
+    const sqidscxx::FixedSqids<Base36, 10, uint32_t> fixed;
+    const sqidscxx::Sqids<uint32_t> sqids({ alphabet: std::string(Base36::value), minLength: 10 });
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        const auto numbers = sqids.numbers({ i, i + 1 });
+        EXPECT_EQ(fixed.encode(numbers), sqids.encode(numbers));
+        EXPECT_EQ(fixed.decode(sqids.encode(numbers)), numbers);
+    }
+}
+
+TEST(Fixed, MatchesInstanceWithAlphabetCache) {
+    const sqidscxx::FixedSqids<Base36, 20> fixed(sqidscxx::Blocklist::defaults(), 3);
+    const sqidscxx::Sqids<> sqids({ alphabet: std::string(Base36::value), minLength: 20 });
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        const auto numbers = sqids.numbers({ i, i * 7, i * 13, i * 31 });
+        EXPECT_EQ(fixed.encode(numbers), sqids.encode(numbers));
+        EXPECT_EQ(fixed.decode(sqids.encode(numbers)), numbers);
+    }
+}
+
+TEST(Fixed, Blocklist) {
+    const sqidscxx::FixedSqids<sqidscxx::DefaultAlphabet> fixed({ "86Rf07" });
+    const sqidscxx::Sqids<> sqids({ blocklist: { "86Rf07" } });
+
+    EXPECT_NE(fixed.encode({ 1, 2, 3 }), "86Rf07");
+    EXPECT_EQ(fixed.encode({ 1, 2, 3 }), sqids.encode({ 1, 2, 3 }));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <sqids/sqids.hpp>
+
+class InstrumentationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { sqidscxx::setInstrumentationSink(&sink); }
+    void TearDown() override { sqidscxx::setInstrumentationSink(nullptr); }
+
+    sqidscxx::CountingSink sink;
+};
+
+TEST_F(InstrumentationTest, CountsEncodes) {
+    sqidscxx::Sqids<> sqids;
+
+    sqids.encode({ 1, 2, 3 });
+    sqids.encode({ 4 });
+    sqids.encode({});
+
+    EXPECT_EQ(sink.encodes, 2u);
+    EXPECT_EQ(sink.regenerations, 0u);
+    EXPECT_EQ(sink.increments[0], 2u);
+}
+
+TEST_F(InstrumentationTest, CountsRegenerations) {
+    sqidscxx::Sqids<> sqids({ blocklist: { "86Rf07", "se8ojk", "ARsz1p", "Q8AI49", "5sQRZO" } });
+
+    EXPECT_EQ(sqids.encode({ 1, 2, 3 }), "KA5FQN");
+
+    EXPECT_EQ(sink.encodes, 1u);
+    EXPECT_EQ(sink.regenerations, 5u);
+    EXPECT_EQ(sink.increments[5], 1u);
+}
+
+TEST_F(InstrumentationTest, CountsFailedEncodes) {
+    sqidscxx::Sqids<> sqids({ alphabet: "abc", minLength: 3, blocklist: { "cab", "abc", "bca" } });
+
+    ASSERT_THROW(sqids.encode({ 0 }), std::runtime_error);
+
+    EXPECT_EQ(sink.encodes, 0u);
+    EXPECT_EQ(sink.encodeFailures, 1u);
+    EXPECT_EQ(sink.regenerations, 3u);
+}
+
+TEST_F(InstrumentationTest, CountsDecodes) {
+    sqidscxx::Sqids<> sqids;
+
+    sqids.decode("86Rf07");
+    sqids.decode("");
+    sqids.decode("*");
+    sqids.decode("86Rf0*");
+
+    const auto emptyId = static_cast<size_t>(sqidscxx::DecodeRejection::EmptyId);
+    const auto invalidCharacter = static_cast<size_t>(sqidscxx::DecodeRejection::InvalidCharacter);
+
+    EXPECT_EQ(sink.decodes, 4u);
+    EXPECT_EQ(sink.rejections[emptyId], 1u);
+    EXPECT_EQ(sink.rejections[invalidCharacter], 2u);
+}
+
+TEST_F(InstrumentationTest, CanonicalDecodingReportsOneDecode) {
+    sqidscxx::Sqids<> unblocked({ blocklist: {} });
+    sqidscxx::Sqids<> sqids({ blocklist: { "aho1e" }, canonicalDecoding: true });
+
+    const auto numbers = unblocked.numbers({ 4572721 });
+    const auto id = sqids.encode(numbers);
+    sink.encodes = 0;
+    sink.regenerations = 0;
+    sink.blocklistNanoseconds = 0;
+
+    // The regenerated ID is checked by generating the attempts before it
+    // again, which isn't reported
+    EXPECT_EQ(sqids.decode(id), numbers);
+    EXPECT_TRUE(sqids.decode("aho1e").empty());
+
+    const auto nonCanonical = static_cast<size_t>(sqidscxx::DecodeRejection::NonCanonical);
+
+    EXPECT_EQ(sink.decodes, 2u);
+    EXPECT_EQ(sink.rejections[nonCanonical], 1u);
+    EXPECT_EQ(sink.encodes, 0u);
+    EXPECT_EQ(sink.regenerations, 0u);
+    EXPECT_EQ(sink.blocklistNanoseconds, 0u);
+}
+
+TEST_F(InstrumentationTest, EveryDecodeEntryPointReportsOnce) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 20; i++) {
+        numbers.push_back(i);
+    }
+    const auto id = sqids.encode(numbers);
+
+    uint64_t buffer[32];
+    sqids.decode(id);
+    sqids.tryDecode(id);
+    sqids.decodeInto(id, buffer, 32);
+    sqids.decode(id, std::allocator<uint64_t>());
+    sqids.decodeFirst(id);
+    sqids.decodePrefix(id, 3);
+    for (auto number : sqids.decodeLazily(id)) {
+        (void)number;
+    }
+    sqids.decodeFirst("*");
+
+    const auto invalidCharacter = static_cast<size_t>(sqidscxx::DecodeRejection::InvalidCharacter);
+
+    EXPECT_EQ(sink.decodes, 8u);
+    EXPECT_EQ(sink.rejections[invalidCharacter], 1u);
+}
+
+TEST_F(InstrumentationTest, NoSink) {
+    sqidscxx::setInstrumentationSink(nullptr);
+
+    sqidscxx::Sqids<> sqids;
+    EXPECT_EQ(sqids.decode(sqids.encode({ 1, 2, 3 })), sqids.numbers({ 1, 2, 3 }));
+    EXPECT_EQ(sink.encodes, 0u);
+    EXPECT_EQ(sink.decodes, 0u);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <sqids/sqids.hpp>
+
+namespace
+{
+uint64_t nextRandom(uint64_t& state)
+{
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return state ^ (state >> 29);
+}
+}  // namespace
+
+#if defined(__SIZEOF_INT128__)
+TEST(Integers, LimbDivisionMatchesNativeDivision) {
+    uint64_t state = 42;
+
+    for (uint64_t divisor : { 2, 3, 10, 61, 127 }) {
+        const sqidscxx::Divider divider(divisor);
+
+        for (int i = 0; i < 1000; i++) {
+            uint64_t limbs[2] = { nextRandom(state), i % 2 ? nextRandom(state) : nextRandom(state) % 1000 };
+            const unsigned __int128 n = (static_cast<unsigned __int128>(limbs[1]) << 64) | limbs[0];
+
+            EXPECT_EQ(sqidscxx::LimbArithmetic::remainder(limbs, 2, divider), static_cast<uint64_t>(n % divisor));
+            EXPECT_EQ(sqidscxx::LimbArithmetic::divide(limbs, 2, divider), static_cast<uint64_t>(n % divisor));
+
+            const unsigned __int128 quotient = n / divisor;
+            EXPECT_EQ(limbs[0], static_cast<uint64_t>(quotient));
+            EXPECT_EQ(limbs[1], static_cast<uint64_t>(quotient >> 64));
+
+            sqidscxx::LimbArithmetic::multiplyAdd(limbs, 2, divisor, static_cast<uint64_t>(n % divisor));
+            EXPECT_EQ(limbs[0], static_cast<uint64_t>(n));
+            EXPECT_EQ(limbs[1], static_cast<uint64_t>(n >> 64));
+        }
+    }
+}
+#endif
+
+TEST(Integers, BigUintToString) {
+    EXPECT_EQ(sqidscxx::BigUint<64>(0).toString(), "0");
+    EXPECT_EQ(sqidscxx::BigUint<64>::max().toString(), "18446744073709551615");
+    EXPECT_EQ(sqidscxx::BigUint<128>::max().toString(), "340282366920938463463374607431768211455");
+    EXPECT_EQ(sqidscxx::BigUint<128>({ 0, 1 }).toString(), "18446744073709551616");
+}
+
+TEST(Integers, SmallNumbersEncodeLikeUint64) {
+    const sqidscxx::Sqids<uint64_t> sqids;
+    const sqidscxx::Sqids<sqidscxx::BigUint<256>> big;
+#if defined(__SIZEOF_INT128__)
+    const sqidscxx::Sqids<unsigned __int128> wide;
+#endif
+
+    uint64_t state = 42;
+    for (int i = 0; i < 1000; i++) {
+        const uint64_t a = nextRandom(state);
+        const uint64_t b = nextRandom(state) >> (i % 64);
+        const std::string id = sqids.encode({ a, b });
+
+#if defined(__SIZEOF_INT128__)
+        EXPECT_EQ(wide.encode({ a, b }), id);
+#endif
+        EXPECT_EQ(big.encode({ a, b }), id);
+        EXPECT_EQ(big.decode(id), big.numbers({ a, b }));
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(Integers, Uint128AndBigUintGiveTheSameIds) {
+    const sqidscxx::Sqids<unsigned __int128> wide;
+    const sqidscxx::Sqids<sqidscxx::BigUint<128>> big;
+
+    uint64_t state = 42;
+    for (int i = 0; i < 1000; i++) {
+        const uint64_t low = nextRandom(state);
+        const uint64_t high = nextRandom(state) >> (i % 64);
+        const unsigned __int128 n = (static_cast<unsigned __int128>(high) << 64) | low;
+
+        const std::string id = wide.encode({ n, 7 });
+        EXPECT_EQ(big.encode({ sqidscxx::BigUint<128>({ low, high }), 7 }), id);
+        EXPECT_EQ(wide.encodedLength({ n, 7 }), id.size());
+
+        const auto decoded = wide.decode(id);
+        ASSERT_EQ(decoded.size(), 2u);
+        EXPECT_TRUE(decoded[0] == n);
+        EXPECT_EQ(big.decode(id), big.numbers({ sqidscxx::BigUint<128>({ low, high }), 7 }));
+    }
+}
+
+#endif
+
+TEST(Integers, MaxValueRoundTrips) {
+    const sqidscxx::Sqids<sqidscxx::BigUint<256>> sqids;
+    const auto max = sqids.maxValue;
+
+    const std::string id = sqids.encode({ max, 0, max });
+    EXPECT_EQ(sqids.decode(id), sqids.numbers({ max, 0, max }));
+    EXPECT_LE(id.size(), sqids.maxEncodedLength(3));
+    EXPECT_EQ(sqids.encodedLength({ max, 0, max }), id.size());
+    EXPECT_EQ(sqids.encodedLength({ max }), sqids.maxEncodedLength(1));
+
+#if defined(__SIZEOF_INT128__)
+    const sqidscxx::Sqids<unsigned __int128> wide;
+    EXPECT_TRUE(wide.decode(wide.encode({ wide.maxValue })).at(0) == wide.maxValue);
+#endif
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <sqids/parallel.hpp>
+
+TEST(Parallel, EncodeMatchesBatch) {
+    sqidscxx::Sqids<> sqids({ minLength: 5 });
+
+    std::vector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 10'000; i++) {
+        numbers.push_back(i);
+        numbers.push_back(i * i);
+    }
+
+    sqidscxx::EncodedBatch expected;
+    sqids.encodeBatch(numbers.data(), numbers.size() / 2, 2, expected);
+
+    for (unsigned int threads : { 1, 3, 8 }) {
+        sqidscxx::EncodedBatch ids;
+        sqidscxx::encodeParallel(sqids, numbers.data(), numbers.size() / 2, 2, ids, threads);
+
+        EXPECT_EQ(ids.buffer, expected.buffer);
+        EXPECT_EQ(ids.offsets, expected.offsets);
+
+        sqidscxx::DecodedBatch<uint64_t> decoded;
+        sqidscxx::decodeParallel(sqids, ids, decoded, threads);
+
+        EXPECT_EQ(decoded.numbers, numbers);
+    }
+}
+
+TEST(Parallel, CustomExecutor) {
+    sqidscxx::Sqids<> sqids;
+
+    const auto numbers(sqids.numbers({ 1, 2, 3, 4, 5, 6, 7 }));
+
+    size_t tasksRun = 0;
+    const sqidscxx::Executor sequential = [&tasksRun](size_t taskCount, const std::function<void(size_t)>& task) {
+        for (size_t i = 0; i < taskCount; i++) {
+            task(i);
+            tasksRun++;
+        }
+    };
+
+    sqidscxx::EncodedBatch ids;
+    sqidscxx::encodeParallel(sqids, numbers.data(), numbers.size(), 1, ids, 4, sequential);
+
+    ASSERT_EQ(ids.size(), numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++) {
+        EXPECT_EQ(ids[i], sqids.encode({ numbers[i] }));
+    }
+    // Once to measure the IDs, once to encode them
+    EXPECT_EQ(tasksRun, 8u);
+}
+
+TEST(Parallel, DecodeStringViews) {
+    sqidscxx::Sqids<> sqids;
+
+    const std::string first(sqids.encode({ 1, 2, 3 }));
+    const std::string second(sqids.encode({ 4 }));
+    const std::string third(sqids.encode({ 5, 6 }));
+    const std::vector<std::string_view> ids = { first, "", second, "*", third };
+
+    sqidscxx::DecodedBatch<uint64_t> expected;
+    sqids.decodeBatch(ids.data(), ids.size(), expected);
+
+    for (unsigned int threads : { 1, 2, 5 }) {
+        sqidscxx::DecodedBatch<uint64_t> decoded;
+        sqidscxx::decodeParallel(sqids, ids.data(), ids.size(), decoded, threads);
+
+        EXPECT_EQ(decoded.numbers, expected.numbers);
+        EXPECT_EQ(decoded.offsets, expected.offsets);
+    }
+
+    EXPECT_EQ(expected.numbers, sqids.numbers({ 1, 2, 3, 4, 5, 6 }));
+}
+
+TEST(Parallel, EncodeErrorsArePropagated) {
+    sqidscxx::Sqids<> sqids({ alphabet: "abc", minLength: 3, blocklist: { "cab", "abc", "bca" } });
+
+    const auto numbers(sqids.numbers({ 0, 0, 0, 0 }));
+
+    sqidscxx::EncodedBatch ids;
+    ASSERT_THROW(sqidscxx::encodeParallel(sqids, numbers.data(), numbers.size(), 1, ids, 2u), std::runtime_error);
+}
+
+TEST(Parallel, ThreadExecutorBoundsThreads) {
+    const auto executor = sqidscxx::threadExecutor(2);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<int> runs(64, 0);
+
+    executor(runs.size(), [&](size_t task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        runs[task]++;
+    });
+
+    EXPECT_EQ(runs, std::vector<int>(64, 1));
+    EXPECT_LE(threads.size(), 2u);
+}
+
+TEST(Parallel, ThreadsRunBothPasses) {
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<int> firstRuns(4, 0);
+    std::vector<int> secondRuns(4, 0);
+    size_t placed = 0;
+
+    sqidscxx::detail::runPasses(
+        4u, firstRuns.size(),
+        [&](size_t task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            firstRuns[task]++;
+        },
+        [&]() {
+            // Every task of the first pass is done before the second starts
+            EXPECT_EQ(firstRuns, std::vector<int>(4, 1));
+            placed++;
+        },
+        [&](size_t task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            EXPECT_EQ(placed, 1u);
+            secondRuns[task]++;
+        });
+
+    EXPECT_EQ(secondRuns, std::vector<int>(4, 1));
+    EXPECT_LE(threads.size(), 4u);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <sqids/registry.hpp>
+#include <thread>
+
+TEST(Registry, ReturnsSameInstanceForSameOptions) {
+    sqidscxx::SqidsRegistry<> registry(1024 * 1024);
+
+    const auto first = registry.get({ alphabet: "0123456789abcdef", minLength: 8 });
+    const auto second = registry.get({ alphabet: "0123456789abcdef", minLength: 8 });
+    const auto third = registry.get({ alphabet: "0123456789abcdef", minLength: 9 });
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, third);
+
+    const auto statistics = registry.statistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 2u);
+    EXPECT_EQ(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.size, 2u);
+
+    // Both instances use the same blocklist matcher, which is counted once
+    ASSERT_EQ(first->blocklistMatcher(), third->blocklistMatcher());
+    EXPECT_EQ(statistics.bytes, first->memoryUsage() + third->memoryUsage() - first->blocklistMatcher()->memoryUsage());
+}
+
+TEST(Registry, EncodesLikeInstance) {
+    sqidscxx::SqidsRegistry<> registry(1024 * 1024);
+    const sqidscxx::Sqids<> sqids({ alphabet: "0123456789abcdef", minLength: 8 });
+
+    const auto cached = registry.get({ alphabet: "0123456789abcdef", minLength: 8 });
+    EXPECT_EQ(cached->encode({ 1, 2, 3 }), sqids.encode({ 1, 2, 3 }));
+}
+
+TEST(Registry, DistinguishesBlocklists) {
+    sqidscxx::SqidsRegistry<> registry(1024 * 1024);
+
+    const auto defaults = registry.get({});
+    const auto empty = registry.get({ blocklist: {} });
+    const auto custom = registry.get({ blocklist: { "abc", "def" } });
+    const auto joined = registry.get({ blocklist: { "abcdef" } });
+
+    EXPECT_NE(defaults, empty);
+    EXPECT_NE(empty, custom);
+    EXPECT_NE(custom, joined);
+    EXPECT_EQ(registry.statistics().misses, 4u);
+}
+
+TEST(Registry, EvictsLeastRecentlyUsed) {
+    const sqidscxx::Sqids<> sqids({ alphabet: "abcdef" });
+    const size_t matcherBytes = sqids.blocklistMatcher()->memoryUsage();
+    const size_t bytes = sqids.memoryUsage() - matcherBytes;
+
+    // Room for two instances of the same size, which share a matcher
+    sqidscxx::SqidsRegistry<> registry(matcherBytes + bytes * 2);
+
+    const auto a = registry.get({ alphabet: "abcdef" });
+    const auto b = registry.get({ alphabet: "bcdefa" });
+    registry.get({ alphabet: "abcdef" });
+    const auto c = registry.get({ alphabet: "cdefab" });
+
+    auto statistics = registry.statistics();
+    EXPECT_EQ(statistics.evictions, 1u);
+    EXPECT_EQ(statistics.size, 2u);
+
+    // "bcdefa" was evicted, but is still usable
+    EXPECT_EQ(b->decode(b->encode({ 42 })), b->numbers({ 42 }));
+    EXPECT_EQ(registry.get({ alphabet: "abcdef" }), a);
+    EXPECT_NE(registry.get({ alphabet: "bcdefa" }), b);
+
+    registry.clear();
+    statistics = registry.statistics();
+    EXPECT_EQ(statistics.size, 0u);
+    EXPECT_EQ(statistics.bytes, 0u);
+}
+
+TEST(Registry, CountsSharedMatchersOnce) {
+    const sqidscxx::Sqids<> sqids;
+    const size_t matcherBytes = sqids.blocklistMatcher()->memoryUsage();
+    const size_t bytes = sqids.memoryUsage() - matcherBytes;
+
+    // Tenants with the default alphabet and blocklist, and different padding
+    sqidscxx::SqidsRegistry<> registry(matcherBytes + bytes * 200);
+    for (uint8_t minLength = 0; minLength < 200; minLength++) {
+        registry.get({ minLength: minLength });
+    }
+
+    auto statistics = registry.statistics();
+    EXPECT_EQ(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.size, 200u);
+    EXPECT_EQ(statistics.bytes, matcherBytes + bytes * 200);
+
+    // Instances with the same custom blocklist share another matcher
+    const auto custom = registry.get({ blocklist: { "abc", "def" } });
+    const auto padded = registry.get({ minLength: 1, blocklist: { "abc", "def" } });
+    ASSERT_EQ(custom->blocklistMatcher(), padded->blocklistMatcher());
+
+    statistics = registry.statistics();
+    EXPECT_GT(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.bytes, matcherBytes + bytes * (statistics.size - 2) + custom->memoryUsage() + bytes);
+}
+
+TEST(Registry, UncountsMatchersOfEvictedInstances) {
+    sqidscxx::SqidsRegistry<> registry(1);
+
+    registry.get({ blocklist: { "abc", "def" } });
+    const auto sqids = registry.get({});
+
+    // Only the most recently used instance is kept, with its own matcher
+    const auto statistics = registry.statistics();
+    EXPECT_EQ(statistics.size, 1u);
+    EXPECT_EQ(statistics.bytes, sqids->memoryUsage());
+}
+
+TEST(Registry, InvalidOptions) {
+    sqidscxx::SqidsRegistry<> registry(1024 * 1024);
+
+    ASSERT_THROW(registry.get({ alphabet: "ab" }), std::runtime_error);
+    EXPECT_EQ(registry.statistics().size, 0u);
+}
+
+TEST(Registry, ConcurrentAccess) {
+    sqidscxx::SqidsRegistry<> registry(64 * 1024);
+    const std::string alphabets[] = { "abcdef", "bcdefa", "cdefab", "defabc" };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&registry, &alphabets, t]() {
+            for (uint64_t i = 0; i < 200; i++) {
+                const auto sqids = registry.get({ alphabet: alphabets[(t + i) % 4] });
+                EXPECT_EQ(sqids->decode(sqids->encode({ i })), sqids->numbers({ i }));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto statistics = registry.statistics();
+    EXPECT_EQ(statistics.hits + statistics.misses, 800u);
+    EXPECT_LE(statistics.size, 4u);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <sqids/stream.hpp>
+
+namespace
+{
+struct Record
+{
+    std::string id;
+    std::vector<uint64_t> numbers;
+};
+
+std::vector<Record> decodeInChunks(const sqidscxx::StreamDecoder<>& prototype, const std::string& input,
+                                   size_t chunkSize)
+{
+    sqidscxx::StreamDecoder<> decoder(prototype);
+    std::vector<Record> records;
+
+    auto collect = [&records](std::string_view id, const uint64_t* numbers, size_t count) {
+        records.push_back({ std::string(id), std::vector<uint64_t>(numbers, numbers + count) });
+    };
+
+    for (size_t i = 0; i < input.size(); i += chunkSize) {
+        decoder.feed(input.data() + i, std::min(chunkSize, input.size() - i), collect);
+    }
+    decoder.finish(collect);
+
+    return records;
+}
+}  // namespace
+
+TEST(Stream, DecodeLines) {
+    sqidscxx::Sqids<> sqids;
+
+    std::string input;
+    std::vector<std::vector<uint64_t>> expected;
+    for (uint64_t i = 0; i < 200; i++) {
+        expected.push_back(sqids.numbers({ i, i * i, 1'000'000 + i }));
+        input += sqids.encode(expected.back()) + "\n";
+    }
+
+    // Records split across chunks in every possible position
+    for (size_t chunkSize : { 1, 2, 7, 64, 4096 }) {
+        const auto records = decodeInChunks(sqidscxx::StreamDecoder<>(sqids), input, chunkSize);
+
+        ASSERT_EQ(records.size(), expected.size()) << chunkSize;
+        for (size_t i = 0; i < records.size(); i++) {
+            EXPECT_EQ(records[i].numbers, expected[i]);
+        }
+    }
+}
+
+TEST(Stream, LastRecordWithoutDelimiter) {
+    sqidscxx::Sqids<> sqids;
+
+    const std::string one = sqids.encode({ 1 });
+    const auto records = decodeInChunks(sqidscxx::StreamDecoder<>(sqids), "86Rf07\r\n" + one + "\n*invalid\n\n" + one, 3);
+
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_EQ(records[0].id, "86Rf07");
+    EXPECT_EQ(records[0].numbers, sqids.numbers({ 1, 2, 3 }));
+    EXPECT_EQ(records[1].numbers, sqids.numbers({ 1 }));
+    EXPECT_TRUE(records[2].numbers.empty());
+    EXPECT_TRUE(records[3].numbers.empty());
+    EXPECT_EQ(records[4].numbers, sqids.numbers({ 1 }));
+}
+
+TEST(Stream, DecodeCsvColumn) {
+    sqidscxx::Sqids<> sqids;
+
+    const std::string one = sqids.encode({ 1 });
+    const std::string input = "time,user,order_id\n"
+                              "1,86Rf07," + one + "\n"
+                              "2," + one + ",86Rf07\n"
+                              "3," + one + "\n";
+
+    const auto records = decodeInChunks(sqidscxx::StreamDecoder<>(sqids, '\n', ',', 2), input, 5);
+
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[0].id, "order_id");
+    EXPECT_TRUE(records[0].numbers.empty());
+    EXPECT_EQ(records[1].numbers, sqids.numbers({ 1 }));
+    EXPECT_EQ(records[2].numbers, sqids.numbers({ 1, 2, 3 }));
+    EXPECT_EQ(records[3].id, "");
+}
+
+TEST(Stream, ManyNumbers) {
+    sqidscxx::Sqids<> sqids;
+
+    std::vector<uint64_t> numbers(100);
+    for (size_t i = 0; i < numbers.size(); i++) {
+        numbers[i] = i * 12345;
+    }
+
+    const auto records = decodeInChunks(sqidscxx::StreamDecoder<>(sqids), sqids.encode(numbers), 16);
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].numbers, numbers);
+}
+
+TEST(Stream, DecodeIntoBatch) {
+    sqidscxx::Sqids<> sqids;
+
+    const std::string input = "86Rf07 " + sqids.encode({ 1 }) + " *";
+
+    sqidscxx::DecodedBatch<uint64_t> batch;
+    sqidscxx::decodeStream(sqids, input.data(), input.size(), batch, ' ');
+
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch.count(0), 3u);
+    EXPECT_EQ(batch.data(0)[2], 3u);
+    EXPECT_EQ(batch.count(1), 1u);
+    EXPECT_EQ(batch.count(2), 0u);
+}
@@ -0,0 +1,100 @@
+//
+// sqids-blocklist: compile a list of blocked words into a binary image, to
+// be loaded with `Blocklist::load()` without compiling it again.
+//
+// Words are read one per line. The image only supports alphabets whose
+// characters are all in the alphabet it was compiled for.
+//
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <sqids/sqids.hpp>
+
+namespace
+{
+void usage()
+{
+    std::cerr << "Usage: sqids-blocklist [options] <words> <output>\n"
+                 "\n"
+                 "Compiles the words in `words`, one per line, and writes the image to `output`.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --alphabet <chars>   The alphabet the blocklist will be used with\n"
+                 "                       (default: the default alphabet)\n"
+                 "  --defaults           Compile the default blocklist instead of `words`\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string alphabet = sqidscxx::SqidsOptions().alphabet;
+    bool defaults = false;
+    const char* wordsPath = nullptr;
+    const char* outputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--alphabet" && hasValue) {
+            alphabet = argv[++i];
+        } else if (arg == "--defaults") {
+            defaults = true;
+        } else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else if (arg[0] != '-' && wordsPath == nullptr && !defaults) {
+            wordsPath = argv[i];
+        } else if (arg[0] != '-' && outputPath == nullptr) {
+            outputPath = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (outputPath == nullptr || (wordsPath == nullptr) == !defaults) {
+        usage();
+        return 1;
+    }
+
+    try {
+        sqidscxx::Blocklist blocklist = sqidscxx::Blocklist::defaults();
+
+        if (!defaults) {
+            std::ifstream words(wordsPath);
+            if (!words) {
+                std::cerr << "sqids-blocklist: cannot open " << wordsPath << std::endl;
+                return 1;
+            }
+
+            blocklist.clear();
+            for (std::string word; std::getline(words, word);) {
+                if (!word.empty() && word.back() == '\r') {
+                    word.pop_back();
+                }
+                if (!word.empty()) {
+                    blocklist.insert(word);
+                }
+            }
+        }
+
+        const std::string image = blocklist.compile(alphabet)->serialize();
+
+        // Errors writing out the stream's buffer only show once it's closed
+        std::ofstream output(outputPath, std::ios::binary);
+        output.write(image.data(), image.size());
+        output.close();
+        if (!output) {
+            std::cerr << "sqids-blocklist: cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sqids-blocklist: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
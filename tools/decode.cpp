@@ -0,0 +1,202 @@
+//
+// sqids-decode: decode the IDs in a text or CSV file, one record per line.
+//
+// For every record, the numbers of its ID are written on a line of their
+// own, separated by commas. Invalid IDs produce an empty line.
+//
+
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <sqids/sqids.hpp>
+#include <sqids/stream.hpp>
+
+namespace
+{
+void usage()
+{
+    std::cerr << "Usage: sqids-decode [options] [file]\n"
+                 "\n"
+                 "Decodes the IDs in `file`, or standard input, one record per line.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --alphabet <chars>   The alphabet the IDs were encoded with\n"
+                 "  --min-length <n>     The minimum length the IDs were encoded with (0 to 255)\n"
+                 "  --delimiter <char>   The character ending every record (default: newline)\n"
+                 "  --separator <char>   The character separating fields, for CSV input\n"
+                 "  --column <n>         The field holding the ID, counting from 0 (default: 0)\n"
+                 "  --cache-depth <n>    The alphabets to precompute per offset, 0 to 255 (default: 4)\n";
+}
+
+// Parse a whole argument as a number no larger than `max`
+template<typename Number>
+bool parseNumber(const char* text, Number max, Number& value)
+{
+    const char* end = text + std::strlen(text);
+
+    uint64_t parsed = 0;
+    const auto result = std::from_chars(text, end, parsed);
+    if (result.ec != std::errc() || result.ptr != end || text == end || parsed > max) {
+        return false;
+    }
+
+    value = static_cast<Number>(parsed);
+    return true;
+}
+
+// Parse a whole argument as a single character
+bool parseCharacter(const char* text, char& value)
+{
+    if (std::strlen(text) != 1) {
+        return false;
+    }
+
+    value = text[0];
+    return true;
+}
+
+class Output
+{
+public:
+    explicit Output(std::FILE* file) : _file(file) { _buffer.reserve(CAPACITY); }
+
+    void number(uint64_t value)
+    {
+        char digits[20];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        _buffer.append(digits, result.ptr);
+    }
+
+    void put(char ch)
+    {
+        _buffer.push_back(ch);
+        if (_buffer.size() >= CAPACITY) {
+            write();
+        }
+    }
+
+    // Write out everything still buffered, here and in the FILE. Must be
+    // called once all of the output has been produced.
+    void flush()
+    {
+        write();
+        if (std::fflush(_file) != 0) {
+            fail();
+        }
+    }
+
+private:
+    void write()
+    {
+        if (std::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size()) {
+            fail();
+        }
+        _buffer.clear();
+    }
+
+    [[noreturn]] static void fail() { throw std::system_error(errno, std::generic_category(), "cannot write output"); }
+
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    std::FILE* _file;
+    std::string _buffer;
+};
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    sqidscxx::SqidsOptions options;
+    options.blocklist.clear();  // Not needed for decoding
+
+    // Most IDs hold a few numbers; precomputing their alphabets pays off
+    // quickly on large inputs
+    options.alphabetCacheDepth = 4;
+
+    char delimiter = '\n';
+    char separator = sqidscxx::StreamDecoder<>::NO_SEPARATOR;
+    size_t column = 0;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        bool valid = true;
+        if (arg == "--alphabet" && hasValue) {
+            options.alphabet = argv[++i];
+        } else if (arg == "--min-length" && hasValue) {
+            valid = parseNumber<uint8_t>(argv[++i], UINT8_MAX, options.minLength);
+        } else if (arg == "--delimiter" && hasValue) {
+            valid = parseCharacter(argv[++i], delimiter);
+        } else if (arg == "--separator" && hasValue) {
+            valid = parseCharacter(argv[++i], separator);
+        } else if (arg == "--column" && hasValue) {
+            valid = parseNumber<size_t>(argv[++i], SIZE_MAX, column);
+        } else if (arg == "--cache-depth" && hasValue) {
+            valid = parseNumber<uint8_t>(argv[++i], UINT8_MAX, options.alphabetCacheDepth);
+        } else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else if (arg[0] != '-' && path == nullptr) {
+            path = argv[i];
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            usage();
+            return 1;
+        }
+    }
+
+    std::FILE* input = path ? std::fopen(path, "rb") : stdin;
+    if (input == nullptr) {
+        std::cerr << "sqids-decode: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    int status = 0;
+    try {
+        const sqidscxx::Sqids<> sqids(options);
+        sqidscxx::StreamDecoder<> decoder(sqids, delimiter, separator, column);
+        Output output(stdout);
+
+        auto write = [&output](std::string_view, const uint64_t* numbers, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                if (i > 0) {
+                    output.put(',');
+                }
+                output.number(numbers[i]);
+            }
+            output.put('\n');
+        };
+
+        std::vector<char> buffer(1 << 20);
+        size_t length;
+        while ((length = std::fread(buffer.data(), 1, buffer.size(), input)) > 0) {
+            decoder.feed(buffer.data(), length, write);
+        }
+        // fread() stops at the end of the input and on errors alike
+        if (std::ferror(input)) {
+            throw std::system_error(errno, std::generic_category(),
+                                    std::string("cannot read ") + (path ? path : "standard input"));
+        }
+        decoder.finish(write);
+        output.flush();
+    } catch (const std::exception& e) {
+        std::cerr << "sqids-decode: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    if (input != stdin) {
+        std::fclose(input);
+    }
+
+    return status;
+}